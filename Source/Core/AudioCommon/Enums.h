@@ -12,4 +12,10 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class ResamplingMethod
+{
+  Linear = 0,
+  WindowedSinc = 1
+};
 }  // namespace AudioCommon
@@ -7,7 +7,14 @@
 #include <cmath>
 #include <cstring>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "AudioCommon/Enums.h"
+#include "AudioCommon/Resampler.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -31,6 +38,32 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
   }
 }
 
+// Converts the mixed samples to the output format, clamping them to [-32767, 32767].
+static void ClampToS16(short* out, const s32* in, size_t count)
+{
+  size_t i = 0;
+#if defined(_M_X86_64)
+  const __m128i min = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4));
+    const __m128i packed = _mm_max_epi16(_mm_packs_epi32(lo, hi), min);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+  }
+#elif defined(_M_ARM_64)
+  const int16x8_t min = vdupq_n_s16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t packed =
+        vcombine_s16(vqmovn_s32(vld1q_s32(in + i)), vqmovn_s32(vld1q_s32(in + i + 4)));
+    vst1q_s16(out + i, vmaxq_s16(packed, min));
+  }
+#endif
+  for (; i < count; i++)
+    out[i] = static_cast<short>(std::clamp(in[i], -32767, 32767));
+}
+
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
@@ -58,12 +91,10 @@ void Mixer::DoState(PointerWrap& p)
 }
 
 // Executed from sound stream thread
-unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
+unsigned int Mixer::MixerFifo::Mix(s32* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -107,32 +138,27 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
-  {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
-  }
-
+  const bool windowed_sinc =
+      m_mixer->m_config_resampling == AudioCommon::ResamplingMethod::WindowedSinc;
+  const u32 taps = windowed_sinc ? AudioCommon::SINC_TAPS : AudioCommon::LINEAR_TAPS;
+
+  // Only copy the frames this call can read, swapping them to host endianness once instead of
+  // once per tap.
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  const u64 needed_frames = ((static_cast<u64>(numSamples) * ratio + m_frac) >> 16) + taps;
+  const u32 staged_frames = static_cast<u32>(std::min<u64>(available_frames, needed_frames));
+  for (u32 i = 0; i < staged_frames * 2; ++i)
+    m_staging[i] = read_buffer((indexR + i) & INDEX_MASK);
+
+  u32 position = m_frac;
+  const auto resample =
+      windowed_sinc ? AudioCommon::ResampleWindowedSinc : AudioCommon::ResampleLinear;
   // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  const unsigned int actual_sample_count = resample(
+      samples, numSamples, m_staging.data(), staged_frames, position, ratio, lvolume, rvolume);
+  indexR += 2 * (position >> 16);
+  m_frac = position & 0xffff;
+  unsigned int currentSample = actual_sample_count * 2;
 
   // Padding
   short s[2];
@@ -140,13 +166,14 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s[1] = read_buffer((indexR - 2) & INDEX_MASK);
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  // A FIFO which has run dry on silence (e.g. an unused GBA or speaker) adds nothing.
+  if (s[0] != 0 || s[1] != 0)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
-
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    for (; currentSample < numSamples * 2; currentSample += 2)
+    {
+      samples[currentSample + 0] += s[0];
+      samples[currentSample + 1] += s[1];
+    }
   }
 
   // Flush cached variable
@@ -155,13 +182,33 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   return actual_sample_count;
 }
 
+void Mixer::MixFifos(short* samples, unsigned int num_samples, bool consider_framelimit,
+                     float emulation_speed, int timing_variance)
+{
+  // All FIFOs are summed at full precision and clamped once at the end, instead of each of them
+  // clamping its own contribution into the 16-bit output.
+  s32* const accumulator = m_mix_buffer.data();
+  std::fill_n(accumulator, num_samples * 2, 0);
+
+  m_dma_mixer.Mix(accumulator, num_samples, consider_framelimit, emulation_speed,
+                  timing_variance);
+  m_streaming_mixer.Mix(accumulator, num_samples, consider_framelimit, emulation_speed,
+                        timing_variance);
+  m_wiimote_speaker_mixer.Mix(accumulator, num_samples, consider_framelimit, emulation_speed,
+                              timing_variance);
+  m_skylander_portal_mixer.Mix(accumulator, num_samples, consider_framelimit, emulation_speed,
+                               timing_variance);
+  for (auto& mixer : m_gba_mixers)
+    mixer.Mix(accumulator, num_samples, consider_framelimit, emulation_speed, timing_variance);
+
+  ClampToS16(samples, accumulator, num_samples * 2);
+}
+
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 {
   if (!samples)
     return 0;
 
-  memset(samples, 0, num_samples * 2 * sizeof(short));
-
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
@@ -176,21 +223,7 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
                m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
                available_samples, MAX_SAMPLES, num_samples);
 
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
-    m_skylander_portal_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                 timing_variance);
-    for (auto& mixer : m_gba_mixers)
-    {
-      mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
-    }
+    MixFifos(m_scratch_buffer.data(), available_samples, false, emulation_speed, timing_variance);
 
     if (!m_is_stretching)
     {
@@ -202,12 +235,12 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    // Backends may ask for more than the mix buffer holds at once.
+    for (unsigned int offset = 0; offset < num_samples; offset += MAX_SAMPLES)
+    {
+      MixFifos(samples + offset * 2, std::min(num_samples - offset, MAX_SAMPLES), true,
+               emulation_speed, timing_variance);
+    }
     m_is_stretching = false;
   }
 
@@ -458,6 +491,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_resampling = Config::Get(Config::MAIN_AUDIO_RESAMPLING);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
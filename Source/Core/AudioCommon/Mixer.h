@@ -7,6 +7,7 @@
 #include <atomic>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/Enums.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
@@ -72,7 +73,9 @@ private:
     }
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
-    unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
+    // Adds the resampled audio to the given interleaved stereo accumulator. Clamping is left to the
+    // caller, once all FIFOs have been added.
+    unsigned int Mix(s32* samples, unsigned int numSamples, bool consider_framelimit,
                      float emulationspeed, int timing_variance);
     void SetInputSampleRateDivisor(unsigned int rate_divisor);
     unsigned int GetInputSampleRateDivisor() const;
@@ -87,6 +90,8 @@ private:
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
     std::atomic<u32> m_indexW{0};
     std::atomic<u32> m_indexR{0};
+    // Host-endian copy of the frames read by the current Mix() call
+    std::array<short, MAX_SAMPLES * 2> m_staging{};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
@@ -94,6 +99,10 @@ private:
     u32 m_frac = 0;
   };
 
+  // Mixes all FIFOs into samples, which is overwritten. numSamples must not exceed MAX_SAMPLES.
+  void MixFifos(short* samples, unsigned int numSamples, bool consider_framelimit,
+                float emulationspeed, int timing_variance);
+
   void RefreshConfig();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
@@ -110,6 +119,7 @@ private:
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  std::array<s32, MAX_SAMPLES * 2> m_mix_buffer{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -120,6 +130,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  AudioCommon::ResamplingMethod m_config_resampling;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
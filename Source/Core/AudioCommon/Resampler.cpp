@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/Resampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon
+{
+namespace
+{
+constexpr u32 PHASE_SHIFT = 16 - 9;
+static_assert(SINC_PHASES == 1u << (16 - PHASE_SHIFT));
+static_assert(SINC_TAPS % 8 == 0);
+
+// Fraction of the input Nyquist frequency that is let through.
+constexpr double SINC_CUTOFF = 0.9;
+constexpr int COEFFICIENT_BITS = 15;
+
+struct FilterBank
+{
+  alignas(16) std::array<std::array<s16, SINC_TAPS>, SINC_PHASES> phases;
+};
+
+// Blackman-windowed sinc, normalized to unity gain at DC for every phase.
+FilterBank GenerateFilterBank()
+{
+  FilterBank bank;
+  for (u32 phase = 0; phase < SINC_PHASES; ++phase)
+  {
+    const double center = SINC_TAPS / 2 - 1 + static_cast<double>(phase) / SINC_PHASES;
+
+    std::array<double, SINC_TAPS> taps;
+    double sum = 0.0;
+    for (u32 tap = 0; tap < SINC_TAPS; ++tap)
+    {
+      const double x = tap - center;
+      const double t = std::numbers::pi * x * SINC_CUTOFF;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(t) / t;
+      const double w = 2.0 * std::numbers::pi * x / SINC_TAPS;
+      const double window = 0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+      taps[tap] = sinc * window;
+      sum += taps[tap];
+    }
+
+    int total = 0;
+    for (u32 tap = 0; tap < SINC_TAPS; ++tap)
+    {
+      bank.phases[phase][tap] =
+          static_cast<s16>(std::lround(taps[tap] / sum * (1 << COEFFICIENT_BITS)));
+      total += bank.phases[phase][tap];
+    }
+
+    // Put the rounding error on the largest tap so that DC passes through unchanged.
+    s16& largest = *std::max_element(bank.phases[phase].begin(), bank.phases[phase].end());
+    largest += static_cast<s16>((1 << COEFFICIENT_BITS) - total);
+  }
+  return bank;
+}
+
+const FilterBank s_filter_bank = GenerateFilterBank();
+
+// Convolves SINC_TAPS frames with one phase of the filter bank. Results are in the
+// COEFFICIENT_BITS fixed-point format.
+void Convolve(const s16* in, const s16* coefficients, s32* ch0, s32* ch1)
+{
+#if defined(_M_X86_64)
+  __m128i sum = _mm_setzero_si128();
+  for (u32 tap = 0; tap < SINC_TAPS; tap += 8)
+  {
+    // c0 c1 c2 c3 c4 c5 c6 c7 -> c0 c1 c0 c1 c2 c3 c2 c3 and c4 c5 c4 c5 c6 c7 c6 c7
+    const __m128i c = _mm_load_si128(reinterpret_cast<const __m128i*>(coefficients + tap));
+    const __m128i c_lo = _mm_unpacklo_epi32(c, c);
+    const __m128i c_hi = _mm_unpackhi_epi32(c, c);
+
+    // a0 b0 a1 b1 a2 b2 a3 b3 -> a0 a1 b0 b1 a2 a3 b2 b3, so that madd sums pairs of one channel
+    constexpr int ORDER = _MM_SHUFFLE(3, 1, 2, 0);
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + tap * 2));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + tap * 2 + 8));
+    lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, ORDER), ORDER);
+    hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, ORDER), ORDER);
+
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(lo, c_lo));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(hi, c_hi));
+  }
+  // a b a b -> (a + a) (b + b)
+  sum = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+  *ch0 = _mm_cvtsi128_si32(sum);
+  *ch1 = _mm_cvtsi128_si32(_mm_srli_si128(sum, 4));
+#elif defined(_M_ARM_64)
+  int32x4_t sum0 = vdupq_n_s32(0);
+  int32x4_t sum1 = vdupq_n_s32(0);
+  for (u32 tap = 0; tap < SINC_TAPS; tap += 8)
+  {
+    const int16x8_t c = vld1q_s16(coefficients + tap);
+    const int16x8x2_t frames = vld2q_s16(in + tap * 2);
+    sum0 = vmlal_s16(sum0, vget_low_s16(frames.val[0]), vget_low_s16(c));
+    sum0 = vmlal_high_s16(sum0, frames.val[0], c);
+    sum1 = vmlal_s16(sum1, vget_low_s16(frames.val[1]), vget_low_s16(c));
+    sum1 = vmlal_high_s16(sum1, frames.val[1], c);
+  }
+  *ch0 = vaddvq_s32(sum0);
+  *ch1 = vaddvq_s32(sum1);
+#else
+  s32 sum0 = 0;
+  s32 sum1 = 0;
+  for (u32 tap = 0; tap < SINC_TAPS; ++tap)
+  {
+    sum0 += in[tap * 2] * coefficients[tap];
+    sum1 += in[tap * 2 + 1] * coefficients[tap];
+  }
+  *ch0 = sum0;
+  *ch1 = sum1;
+#endif
+}
+}  // namespace
+
+u32 ResampleLinear(s32* out, u32 out_frames, const s16* in, u32 in_frames, u32& position,
+                   u32 ratio, s32 lvolume, s32 rvolume)
+{
+  u32 frame = 0;
+  for (; frame < out_frames; ++frame)
+  {
+    const u32 index = position >> 16;
+    if (index + LINEAR_TAPS > in_frames)
+      break;
+
+    const u16 frac = static_cast<u16>(position);
+    const s16* current = in + index * 2;
+
+    const s16 l1 = current[0];
+    const s16 l2 = current[2];
+    const int sample_l = ((l1 << 16) + (l2 - l1) * frac) >> 16;
+    out[frame * 2 + 1] += (sample_l * lvolume) >> 8;
+
+    const s16 r1 = current[1];
+    const s16 r2 = current[3];
+    const int sample_r = ((r1 << 16) + (r2 - r1) * frac) >> 16;
+    out[frame * 2] += (sample_r * rvolume) >> 8;
+
+    position += ratio;
+  }
+  return frame;
+}
+
+u32 ResampleWindowedSinc(s32* out, u32 out_frames, const s16* in, u32 in_frames, u32& position,
+                         u32 ratio, s32 lvolume, s32 rvolume)
+{
+  constexpr s32 ROUNDING = 1 << (COEFFICIENT_BITS - 1);
+
+  u32 frame = 0;
+  for (; frame < out_frames; ++frame)
+  {
+    const u32 index = position >> 16;
+    if (index + SINC_TAPS > in_frames)
+      break;
+
+    const u32 phase = (position & 0xffff) >> PHASE_SHIFT;
+
+    s32 sample_l, sample_r;
+    Convolve(in + index * 2, s_filter_bank.phases[phase].data(), &sample_l, &sample_r);
+    sample_l = (sample_l + ROUNDING) >> COEFFICIENT_BITS;
+    sample_r = (sample_r + ROUNDING) >> COEFFICIENT_BITS;
+
+    out[frame * 2 + 1] += (sample_l * lvolume) >> 8;
+    out[frame * 2] += (sample_r * rvolume) >> 8;
+
+    position += ratio;
+  }
+  return frame;
+}
+}  // namespace AudioCommon
@@ -0,0 +1,31 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Resampling kernels used by the mixer. They read interleaved stereo frames from a linear,
+// host-endian buffer and add the volume-scaled result to an interleaved stereo accumulator.
+// Following the mixer's channel order, the first input channel is scaled by lvolume and written to
+// the second output channel, and vice versa.
+//
+// position is the 16.16 fixed-point read position in frames and is advanced by ratio for every
+// output frame. Both kernels stop when out_frames frames have been written or the input does not
+// hold enough frames for the next one, and return the number of frames written.
+
+// Frames needed by the linear interpolator to produce an output frame.
+constexpr u32 LINEAR_TAPS = 2;
+
+u32 ResampleLinear(s32* out, u32 out_frames, const s16* in, u32 in_frames, u32& position,
+                   u32 ratio, s32 lvolume, s32 rvolume);
+
+// Windowed-sinc polyphase filter. Output frames are delayed by SINC_TAPS / 2 - 1 input frames.
+constexpr u32 SINC_TAPS = 16;
+constexpr u32 SINC_PHASES = 512;
+
+u32 ResampleWindowedSinc(s32* out, u32 out_frames, const s16* in, u32 in_frames, u32& position,
+                         u32 ratio, s32 lvolume, s32 rvolume);
+}  // namespace AudioCommon
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+// Returns how many threads item_count items should be split over so that each thread gets at
+// least min_items_per_thread items, without using more threads than the host has.
+inline size_t GetParallelThreadCount(size_t item_count, size_t min_items_per_thread = 1)
+{
+  return std::clamp<size_t>(item_count / min_items_per_thread, 1,
+                            std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Splits [0, item_count) into contiguous ranges, as many as GetParallelThreadCount returns, and
+// calls function(begin, end) for each range on its own thread. The futures are in range order, so
+// callers that combine the results in that order get the same result as a single-threaded loop.
+template <typename Function>
+auto RunInParallel(size_t item_count, size_t min_items_per_thread, const Function& function)
+{
+  using Result = std::invoke_result_t<const Function&, size_t, size_t>;
+
+  const size_t threads = GetParallelThreadCount(item_count, min_items_per_thread);
+  std::vector<std::future<Result>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(std::launch::async, function, i * item_count / threads,
+                            (i + 1) * item_count / threads);
+  }
+  return futures;
+}
+}  // namespace Common
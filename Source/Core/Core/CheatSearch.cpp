@@ -3,18 +3,25 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
 #include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/ParallelUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -198,19 +205,13 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 {
   return PowerPC::MMU::HostTryReadF64(guard, addr, space);
 }
-}  // namespace
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+Cheats::SearchErrorCode CheckSearchState(const Core::CPUThreadGuard& guard,
+                                         PowerPC::RequestedAddressSpace address_space)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
   auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
   const Core::State core_state = Core::GetState(system);
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -219,6 +220,384 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  return Cheats::SearchErrorCode::Success;
+}
+
+// Compact searches that would need more memory than this for their copy of the searched memory
+// are done one value at a time instead.
+constexpr size_t MAX_SNAPSHOT_SIZE = 0x10000000;
+
+// Below this many words of the bitmap per thread, starting threads costs more than it saves.
+constexpr size_t MIN_WORDS_PER_THREAD = 1024;
+
+// Copies the memory of all ranges of the given results, translating the address of each page
+// once instead of the address of each value.
+void ReadSnapshot(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace space,
+                  bool translate, const Cheats::CompactSearchResults& results,
+                  std::vector<u8>* snapshot, std::vector<u8>* accessible_pages)
+{
+  auto& system = guard.GetSystem();
+  auto& memory = system.GetMemory();
+  auto& mmu = system.GetMMU();
+
+  for (const Cheats::CompactSearchResults::Range& range : results.ranges)
+  {
+    const u64 end_address =
+        range.first_address + (range.value_count - 1) * results.increment + results.value_size;
+    u8* out = snapshot->data() + range.snapshot_offset;
+    size_t page = range.first_page;
+    for (u64 address = range.first_address; address < end_address; ++page)
+    {
+      const u64 page_end = std::min<u64>((address | PowerPC::HW_PAGE_MASK) + 1, end_address);
+      const size_t size = static_cast<size_t>(page_end - address);
+
+      std::optional<u32> physical_address = static_cast<u32>(address);
+      if (translate)
+        physical_address = mmu.GetTranslatedAddress(static_cast<u32>(address));
+
+      const std::span<const u8> ram =
+          physical_address ? memory.TryGetSpanForAddress(*physical_address) : std::span<u8>();
+      if (ram.size() >= size)
+      {
+        std::memcpy(out, ram.data(), size);
+        (*accessible_pages)[page] = 1;
+      }
+      else if (PowerPC::MMU::HostIsRAMAddress(guard, static_cast<u32>(address), space))
+      {
+        // The locked L1 cache or the fake VMEM, which are rarely searched.
+        for (size_t i = 0; i < size; ++i)
+        {
+          const auto value =
+              PowerPC::MMU::HostTryReadU8(guard, static_cast<u32>(address + i), space);
+          out[i] = value ? value->value : 0;
+        }
+        (*accessible_pages)[page] = 1;
+      }
+      else
+      {
+        std::memset(out, 0, size);
+        (*accessible_pages)[page] = 0;
+      }
+
+      out += size;
+      address = page_end;
+    }
+  }
+}
+
+template <typename T>
+T ReadValue(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+constexpr u64 LowBits(u32 count)
+{
+  return count == 64 ? ~u64(0) : (u64(1) << count) - 1;
+}
+
+// Returns a mask of which of the count values starting at the given one are on accessible pages.
+u64 GetAccessibleMask(const Cheats::CompactSearchResults& results,
+                      const Cheats::CompactSearchResults::Range& range,
+                      const std::vector<u8>& accessible_pages, u64 first_value, u32 count)
+{
+  const auto page_of = [&](u64 value) {
+    const u64 address = range.first_address + value * results.increment;
+    return range.first_page + ((address >> 12) - (range.first_address >> 12));
+  };
+
+  const size_t first_page = page_of(first_value);
+  const size_t last_page = page_of(first_value + count - 1);
+  if (std::all_of(&accessible_pages[first_page], &accessible_pages[last_page] + 1,
+                  [](u8 accessible) { return accessible != 0; }))
+  {
+    return LowBits(count);
+  }
+
+  u64 mask = 0;
+  for (u32 i = 0; i < count; ++i)
+    mask |= u64(accessible_pages[page_of(first_value + i)] != 0) << i;
+  return mask;
+}
+
+// Returns a mask of which of the count values starting at new_data match the predicate. There are
+// no branches in the loop, so that it can be vectorized.
+template <typename T, u32 increment, typename Predicate>
+u64 MatchValues(const u8* new_data, const u8* old_data, u32 count, const Predicate& predicate)
+{
+  u64 mask = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const T new_value = ReadValue<T>(new_data + i * increment);
+    const T old_value = ReadValue<T>(old_data + i * increment);
+    mask |= u64(predicate(new_value, old_value)) << i;
+  }
+  return mask;
+}
+
+// Filters the results in the given words of the bitmap against the values in the snapshot, and
+// returns how many of the remaining ones are accessible.
+template <typename T, u32 increment, typename Predicate>
+size_t FilterWords(Cheats::CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+                   const std::vector<u8>& old_accessible_pages, bool new_search,
+                   size_t begin_word, size_t end_word, const Predicate& predicate)
+{
+  size_t valid_value_count = 0;
+  for (size_t word = begin_word; word < end_word; ++word)
+  {
+    u64 bits = results->bitmap[word];
+    if (bits == 0)
+      continue;
+
+    const size_t bit = word * 64;
+    const Cheats::CompactSearchResults::Range& range = results->GetRange(bit);
+    const u64 first_value = bit - range.first_bit;
+    const u32 count = static_cast<u32>(std::min<u64>(64, range.value_count - first_value));
+    const size_t offset = range.snapshot_offset + first_value * increment;
+
+    const u64 match = MatchValues<T, increment>(results->snapshot.data() + offset,
+                                                old_snapshot.data() + offset, count, predicate);
+    const u64 accessible =
+        GetAccessibleMask(*results, range, results->accessible_pages, first_value, count);
+    if (new_search)
+    {
+      bits &= match & accessible;
+    }
+    else
+    {
+      // Like in NextSearch, inaccessible values are kept, and so are values that were
+      // inaccessible in the previous search.
+      const u64 was_accessible =
+          GetAccessibleMask(*results, range, old_accessible_pages, first_value, count);
+      bits &= match | ~accessible | ~was_accessible;
+    }
+
+    results->bitmap[word] = bits;
+    valid_value_count += std::popcount(bits & accessible);
+  }
+  return valid_value_count;
+}
+
+template <typename T, u32 increment, typename Predicate>
+size_t FilterBitmap(Cheats::CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+                    const std::vector<u8>& old_accessible_pages, bool new_search,
+                    const Predicate& predicate)
+{
+  auto futures = Common::RunInParallel(
+      results->bitmap.size(), MIN_WORDS_PER_THREAD, [&](size_t begin_word, size_t end_word) {
+        return FilterWords<T, increment>(results, old_snapshot, old_accessible_pages, new_search,
+                                         begin_word, end_word, predicate);
+      });
+
+  size_t valid_value_count = 0;
+  for (std::future<size_t>& future : futures)
+    valid_value_count += future.get();
+  return valid_value_count;
+}
+
+template <typename T, typename Function>
+auto VisitCompareFunction(Cheats::CompareType op, const Function& function)
+{
+  switch (op)
+  {
+  case Cheats::CompareType::Equal:
+    return function(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return function(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return function(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return function(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return function(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return function(std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+    return function(std::equal_to<T>());
+  }
+}
+}  // namespace
+
+size_t Cheats::CompactSearchResults::FindBit(size_t result_index) const
+{
+  const auto block_it = std::upper_bound(block_ranks.begin(), block_ranks.end(), result_index);
+  const size_t block = static_cast<size_t>(block_it - block_ranks.begin()) - 1;
+
+  size_t rank = block_ranks[block];
+  for (size_t word = block * BLOCK_WORDS;; ++word)
+  {
+    u64 bits = bitmap[word];
+    const size_t count = std::popcount(bits);
+    if (rank + count > result_index)
+    {
+      for (; rank < result_index; ++rank)
+        bits &= bits - 1;
+      return word * 64 + std::countr_zero(bits);
+    }
+    rank += count;
+  }
+}
+
+size_t Cheats::CompactSearchResults::FindNextBit(size_t bit) const
+{
+  ++bit;
+  size_t word = bit / 64;
+  u64 bits = bit % 64 == 0 ? bitmap[word] : bitmap[word] & ~LowBits(bit % 64);
+  while (bits == 0)
+    bits = bitmap[++word];
+  return word * 64 + std::countr_zero(bits);
+}
+
+const Cheats::CompactSearchResults::Range&
+Cheats::CompactSearchResults::GetRange(size_t bit) const
+{
+  const auto it =
+      std::upper_bound(ranges.begin(), ranges.end(), bit,
+                       [](size_t value, const Range& range) { return value < range.first_bit; });
+  return *(it - 1);
+}
+
+u32 Cheats::CompactSearchResults::GetAddress(size_t bit) const
+{
+  const Range& range = GetRange(bit);
+  return static_cast<u32>(range.first_address + (bit - range.first_bit) * increment);
+}
+
+const u8* Cheats::CompactSearchResults::GetData(size_t bit) const
+{
+  const Range& range = GetRange(bit);
+  return snapshot.data() + range.snapshot_offset + (bit - range.first_bit) * increment;
+}
+
+bool Cheats::CompactSearchResults::IsAccessible(size_t bit) const
+{
+  const Range& range = GetRange(bit);
+  const u32 address = static_cast<u32>(range.first_address + (bit - range.first_bit) * increment);
+  return accessible_pages[range.first_page + ((address >> 12) - (range.first_address >> 12))] != 0;
+}
+
+void Cheats::CompactSearchResults::UpdateCounts()
+{
+  block_ranks.resize((bitmap.size() + BLOCK_WORDS - 1) / BLOCK_WORDS);
+  size_t count = 0;
+  for (size_t word = 0; word < bitmap.size(); ++word)
+  {
+    if (word % BLOCK_WORDS == 0)
+      block_ranks[word / BLOCK_WORDS] = count;
+    count += std::popcount(bitmap[word]);
+  }
+  result_count = count;
+}
+
+std::optional<Cheats::CompactSearchResults>
+Cheats::MakeCompactSearchResults(const std::vector<MemoryRange>& memory_ranges, bool aligned,
+                                 u32 value_size)
+{
+  Cheats::CompactSearchResults results;
+  results.value_size = value_size;
+  results.increment = aligned ? value_size : 1;
+
+  size_t bit_count = 0;
+  size_t snapshot_size = 0;
+  size_t page_count = 0;
+  for (const Cheats::MemoryRange& range : memory_ranges)
+  {
+    if (range.m_length < value_size)
+      continue;
+
+    // Must stay in sync with NewSearch.
+    const u32 first_address = aligned ? Common::AlignUp(range.m_start, value_size) : range.m_start;
+    const u64 aligned_length = range.m_length - (first_address - range.m_start);
+    if (aligned_length < value_size)
+      continue;
+
+    const u64 length = aligned_length - (value_size - 1);
+    const u64 value_count = (length + results.increment - 1) / results.increment;
+    const u64 end_address = first_address + (value_count - 1) * results.increment + value_size;
+
+    results.ranges.push_back({first_address, value_count, bit_count, snapshot_size, page_count});
+    bit_count += Common::AlignUp(value_count, 64);
+    snapshot_size += end_address - first_address;
+    page_count += ((end_address - 1) >> 12) - (first_address >> 12) + 1;
+    if (snapshot_size > MAX_SNAPSHOT_SIZE)
+      return std::nullopt;
+  }
+
+  results.snapshot.resize(snapshot_size);
+  results.accessible_pages.resize(page_count);
+
+  // Every value is a result until the first search filters them.
+  results.bitmap.resize(bit_count / 64);
+  for (const Cheats::CompactSearchResults::Range& range : results.ranges)
+  {
+    u64* const words = results.bitmap.data() + range.first_bit / 64;
+    std::fill(words, words + range.value_count / 64, ~u64(0));
+    if (range.value_count % 64 != 0)
+      words[range.value_count / 64] = (u64(1) << (range.value_count % 64)) - 1;
+  }
+
+  return results;
+}
+
+template <typename T>
+void Cheats::FilterCompactSearchResults(CompactSearchResults* results,
+                                        const std::vector<u8>& old_snapshot,
+                                        const std::vector<u8>& old_accessible_pages,
+                                        bool new_search, FilterType filter_type,
+                                        CompareType compare_type, const std::optional<T>& value)
+{
+  const auto filter = [&](const auto& predicate) {
+    const std::vector<u8>& previous_snapshot = new_search ? results->snapshot : old_snapshot;
+    if (results->increment == sizeof(T))
+    {
+      return FilterBitmap<T, sizeof(T)>(results, previous_snapshot, old_accessible_pages,
+                                        new_search, predicate);
+    }
+    return FilterBitmap<T, 1>(results, previous_snapshot, old_accessible_pages, new_search,
+                              predicate);
+  };
+
+  switch (filter_type)
+  {
+  case FilterType::CompareAgainstSpecificValue:
+    results->valid_value_count = VisitCompareFunction<T>(compare_type, [&](auto compare) {
+      const T specific_value = *value;
+      return filter([compare, specific_value](const T& new_value, const T&) {
+        return compare(new_value, specific_value);
+      });
+    });
+    break;
+  case FilterType::CompareAgainstLastValue:
+    results->valid_value_count = VisitCompareFunction<T>(compare_type, [&](auto compare) {
+      return filter([compare](const T& new_value, const T& old_value) {
+        return compare(new_value, old_value);
+      });
+    });
+    break;
+  case FilterType::DoNotFilter:
+    results->valid_value_count = filter([](const T&, const T&) { return true; });
+    break;
+  }
+
+  results->UpdateCounts();
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  const Cheats::SearchErrorCode error_code = CheckSearchState(guard, address_space);
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  std::vector<Cheats::SearchResult<T>> results;
+
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
@@ -260,17 +639,11 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
                    PowerPC::RequestedAddressSpace address_space,
                    const std::function<bool(const T& new_value, const T& old_value)>& validator)
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState(system);
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return Cheats::SearchErrorCode::NoEmulationActive;
+  const Cheats::SearchErrorCode error_code = CheckSearchState(guard, address_space);
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
 
-  const auto& ppc_state = system.GetPPCState();
-  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+  std::vector<Cheats::SearchResult<T>> results;
 
   for (const auto& previous_result : previous_results)
   {
@@ -372,6 +745,7 @@ void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
   m_search_results.clear();
+  m_compact_results.reset();
 }
 
 template <typename T>
@@ -427,13 +801,25 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue && !m_value)
+    return Cheats::SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstLastValue && !m_first_search_done)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
+  if (const std::optional<SearchErrorCode> error_code = RunCompactSearch(guard))
+    return *error_code;
+
+  // The memory can't be read directly anymore, so continue one value at a time.
+  if (m_compact_results)
+  {
+    m_search_results = ToSearchResults(0, GetResultCount());
+    m_compact_results.reset();
+  }
+
   Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
       Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
-    if (!m_value)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
     auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
     if (m_first_search_done)
     {
@@ -448,9 +834,6 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
-    if (!m_first_search_done)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
     result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
                                    MakeCompareFunctionForLastValue<T>(m_compare_type));
   }
@@ -478,6 +861,81 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
   return result.Error();
 }
 
+template <typename T>
+std::optional<Cheats::SearchErrorCode>
+Cheats::CheatSearchSession<T>::RunCompactSearch(const Core::CPUThreadGuard& guard)
+{
+  const SearchErrorCode error_code = CheckSearchState(guard, m_address_space);
+  if (error_code != SearchErrorCode::Success)
+    return error_code;
+
+  // With the data cache emulated, values can be newer in the cache than in RAM.
+  const auto& ppc_state = guard.GetSystem().GetPPCState();
+  if (ppc_state.m_enable_dcache)
+    return std::nullopt;
+
+  const bool new_search = !m_first_search_done;
+  if (new_search)
+    m_compact_results = MakeCompactSearchResults(m_memory_ranges, m_aligned, sizeof(T));
+  if (!m_compact_results)
+    return std::nullopt;
+
+  CompactSearchResults& results = *m_compact_results;
+  results.translated = m_address_space == PowerPC::RequestedAddressSpace::Virtual ||
+                       (m_address_space == PowerPC::RequestedAddressSpace::Effective &&
+                        ppc_state.msr.DR);
+
+  std::vector<u8> old_snapshot;
+  std::vector<u8> old_accessible_pages;
+  if (!new_search)
+  {
+    old_snapshot.resize(results.snapshot.size());
+    old_accessible_pages.resize(results.accessible_pages.size());
+    std::swap(old_snapshot, results.snapshot);
+    std::swap(old_accessible_pages, results.accessible_pages);
+  }
+  ReadSnapshot(guard, m_address_space, results.translated, results, &results.snapshot,
+               &results.accessible_pages);
+
+  FilterCompactSearchResults<T>(&results, old_snapshot, old_accessible_pages, new_search,
+                                m_filter_type, m_compare_type, m_value);
+  m_first_search_done = true;
+  return SearchErrorCode::Success;
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+Cheats::CheatSearchSession<T>::ToSearchResults(size_t begin_index, size_t end_index) const
+{
+  if (!m_compact_results)
+  {
+    return std::vector<SearchResult<T>>(m_search_results.begin() + begin_index,
+                                        m_search_results.begin() + end_index);
+  }
+
+  const CompactSearchResults& compact = *m_compact_results;
+  std::vector<SearchResult<T>> results;
+  results.reserve(end_index - begin_index);
+  size_t bit = 0;
+  for (size_t i = begin_index; i < end_index; ++i)
+  {
+    bit = i == begin_index ? compact.FindBit(i) : compact.FindNextBit(bit);
+    auto& r = results.emplace_back();
+    r.m_address = compact.GetAddress(bit);
+    if (compact.IsAccessible(bit))
+    {
+      r.m_value = ReadValue<T>(compact.GetData(bit));
+      r.m_value_state = compact.translated ? SearchResultValueState::ValueFromVirtualMemory :
+                                             SearchResultValueState::ValueFromPhysicalMemory;
+    }
+    else
+    {
+      r.m_value_state = SearchResultValueState::AddressNotAccessible;
+    }
+  }
+  return results;
+}
+
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetMemoryRangeCount() const
 {
@@ -523,12 +981,17 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
+  if (m_compact_results)
+    return m_compact_results->result_count;
   return m_search_results.size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
+  if (m_compact_results)
+    return m_compact_results->valid_value_count;
+
   const auto& results = m_search_results;
   size_t count = 0;
   for (const auto& r : results)
@@ -542,19 +1005,27 @@ size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
+  if (m_compact_results)
+    return m_compact_results->GetAddress(m_compact_results->FindBit(index));
   return m_search_results[index].m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
+  if (m_compact_results)
+  {
+    const size_t bit = m_compact_results->FindBit(index);
+    return m_compact_results->IsAccessible(bit) ? ReadValue<T>(m_compact_results->GetData(bit)) :
+                                                  T{};
+  }
   return m_search_results[index].m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
@@ -563,31 +1034,38 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
+  const T value = GetResultValue(index);
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
     {
-      return fmt::format("0x{0:08x}", std::bit_cast<s32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", std::bit_cast<s32>(value));
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-      return fmt::format("0x{0:016x}", std::bit_cast<s64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", std::bit_cast<s64>(value));
     }
     else
     {
-      return fmt::format("0x{0:0{1}x}",
-                         std::bit_cast<std::make_unsigned_t<T>>(m_search_results[index].m_value),
+      return fmt::format("0x{0:0{1}x}", std::bit_cast<std::make_unsigned_t<T>>(value),
                          sizeof(T) * 2);
     }
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
+  if (m_compact_results)
+  {
+    if (!m_compact_results->IsAccessible(m_compact_results->FindBit(index)))
+      return SearchResultValueState::AddressNotAccessible;
+    return m_compact_results->translated ? SearchResultValueState::ValueFromVirtualMemory :
+                                           SearchResultValueState::ValueFromPhysicalMemory;
+  }
   return m_search_results[index].m_value_state;
 }
 
@@ -607,13 +1085,11 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
-    return Clone();
-
+  // Even when every result is in the range, only copy out their values instead of the whole
+  // snapshot, since the table refreshes its visible rows through this every field.
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  c->m_search_results = ToSearchResults(begin_index, end_index);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -621,6 +1097,47 @@ Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size
   return c;
 }
 
+template void Cheats::FilterCompactSearchResults<u8>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<u8>& value);
+template void Cheats::FilterCompactSearchResults<u16>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<u16>& value);
+template void Cheats::FilterCompactSearchResults<u32>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<u32>& value);
+template void Cheats::FilterCompactSearchResults<u64>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<u64>& value);
+template void Cheats::FilterCompactSearchResults<s8>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<s8>& value);
+template void Cheats::FilterCompactSearchResults<s16>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<s16>& value);
+template void Cheats::FilterCompactSearchResults<s32>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<s32>& value);
+template void Cheats::FilterCompactSearchResults<s64>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<s64>& value);
+template void Cheats::FilterCompactSearchResults<float>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<float>& value);
+template void Cheats::FilterCompactSearchResults<double>(
+    CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+    const std::vector<u8>& old_accessible_pages, bool new_search, FilterType filter_type,
+    CompareType compare_type, const std::optional<double>& value);
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
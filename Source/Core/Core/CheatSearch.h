@@ -175,6 +175,71 @@ public:
                                                                size_t end_index) const = 0;
 };
 
+// The results of a search whose memory ranges could all be copied straight out of the emulated
+// RAM. Instead of one SearchResult per match, this holds a copy of the searched memory and one bit
+// per address that can hold a value, which keeps searches over all of MEM1 and MEM2 small and
+// quick to refine.
+struct CompactSearchResults
+{
+  struct Range
+  {
+    // Address of the first value that can match. The following ones are every
+    // CompactSearchResults::increment bytes.
+    u32 first_address;
+    u64 value_count;
+    // Index of the first bit of this range. Always a multiple of 64, so no word of the bitmap is
+    // shared by two ranges.
+    size_t first_bit;
+    size_t snapshot_offset;
+    size_t first_page;
+  };
+
+  // Returns the index of the bit of the result with the given index.
+  size_t FindBit(size_t result_index) const;
+  // Returns the index of the next set bit after the given one, which must not be the last one.
+  size_t FindNextBit(size_t bit) const;
+  const Range& GetRange(size_t bit) const;
+  u32 GetAddress(size_t bit) const;
+  const u8* GetData(size_t bit) const;
+  bool IsAccessible(size_t bit) const;
+
+  // Recounts the results after the bitmap has changed.
+  void UpdateCounts();
+
+  std::vector<Range> ranges;
+  u32 value_size = 0;
+  u32 increment = 0;
+  // Whether the values were read through address translation.
+  bool translated = false;
+
+  // The searched memory in emulated (big endian) byte order. Inaccessible pages are zero.
+  std::vector<u8> snapshot;
+  // One entry per page that a range touches, which is nonzero if the page could be read.
+  std::vector<u8> accessible_pages;
+
+  std::vector<u64> bitmap;
+  // The number of results before every block of BLOCK_WORDS words of the bitmap.
+  static constexpr size_t BLOCK_WORDS = 8;
+  std::vector<size_t> block_ranks;
+  size_t result_count = 0;
+  size_t valid_value_count = 0;
+};
+
+// Creates compact results for the given memory ranges in which every value is a result, or nothing
+// if the copy of the searched memory would be too large.
+std::optional<CompactSearchResults>
+MakeCompactSearchResults(const std::vector<MemoryRange>& memory_ranges, bool aligned,
+                         u32 value_size);
+
+// Filters the given results against the values in their snapshot, with the same semantics as
+// NewSearch for a new search and as NextSearch otherwise. For a next search, old_snapshot and
+// old_accessible_pages hold the memory of the previous search.
+template <typename T>
+void FilterCompactSearchResults(CompactSearchResults* results, const std::vector<u8>& old_snapshot,
+                                const std::vector<u8>& old_accessible_pages, bool new_search,
+                                FilterType filter_type, CompareType compare_type,
+                                const std::optional<T>& value);
+
 template <typename T>
 class CheatSearchSession final : public CheatSearchSessionBase
 {
@@ -217,7 +282,12 @@ public:
                                                        size_t end_index) const override;
 
 private:
+  std::vector<SearchResult<T>> ToSearchResults(size_t begin_index, size_t end_index) const;
+  std::optional<SearchErrorCode> RunCompactSearch(const Core::CPUThreadGuard& guard);
+
   std::vector<SearchResult<T>> m_search_results;
+  // Used instead of m_search_results while every search could read the memory directly.
+  std::optional<CompactSearchResults> m_compact_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
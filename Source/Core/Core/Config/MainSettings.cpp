@@ -27,6 +27,7 @@
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "DiscIO/Enums.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -58,6 +59,8 @@ const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "D
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<AudioCommon::ResamplingMethod> MAIN_AUDIO_RESAMPLING{
+    {System::Main, "Core", "AudioResampling"}, AudioCommon::ResamplingMethod::Linear};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot)
@@ -246,6 +249,11 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<u32> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 0};
+const Info<State::CompressionType> MAIN_SAVESTATE_COMPRESSION{
+    {System::Main, "Core", "SaveStateCompression"}, State::CompressionType::LZ4};
+const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL{{System::Main, "Core", "SaveStateCompressionLevel"},
+                                                 0};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -273,6 +281,7 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "DSPThread"}, false};
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const Info<bool> MAIN_DSP_JIT_PROFILING{{System::Main, "DSP", "JITProfiling"}, false};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const Info<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
 const Info<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
@@ -464,6 +473,8 @@ const Info<bool> MAIN_GAMELIST_COLUMN_TAGS{{System::Main, "GameList", "ColumnTag
 const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY{{System::Main, "FifoPlayer", "LoopReplay"}, true};
 const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES{
     {System::Main, "FifoPlayer", "EarlyMemoryUpdates"}, false};
+const Info<bool> MAIN_FIFOPLAYER_COMPRESS_LOGS{{System::Main, "FifoPlayer", "CompressLogs"},
+                                               false};
 
 // Main.AutoUpdate
 
@@ -511,6 +522,12 @@ const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF{{System::Main, "Debug", "JitR
                                                    false};
 const Info<bool> MAIN_DEBUG_JIT_ENABLE_PROFILING{{System::Main, "Debug", "JitEnableProfiling"},
                                                  false};
+const Info<std::string> MAIN_DEBUG_JIT_PROFILE_OUTPUT{{System::Main, "Debug", "JitProfileOutput"},
+                                                      ""};
+const Info<std::string> MAIN_DEBUG_CODE_TRACE_OUTPUT{{System::Main, "Debug", "CodeTraceOutput"},
+                                                     ""};
+const Info<u32> MAIN_DEBUG_CODE_TRACE_RECORDS{{System::Main, "Debug", "CodeTraceRecords"},
+                                              1 << 20};
 
 // Main.BluetoothPassthrough
 
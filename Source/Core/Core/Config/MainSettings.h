@@ -27,9 +27,15 @@ namespace PowerPC
 enum class CPUCore;
 }
 
+namespace State
+{
+enum CompressionType : u16;
+}
+
 namespace AudioCommon
 {
 enum class DPL2Quality;
+enum class ResamplingMethod;
 }
 
 namespace ExpansionInterface
@@ -74,6 +80,7 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<AudioCommon::ResamplingMethod> MAIN_AUDIO_RESAMPLING;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -150,6 +157,11 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// Seconds between saves to the in-memory rewind buffer. 0 disables rewinding.
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+extern const Info<State::CompressionType> MAIN_SAVESTATE_COMPRESSION;
+// Only used by Zstd. 0 selects the default level of the compression library.
+extern const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -161,6 +173,7 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 extern const Info<bool> MAIN_DSP_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+extern const Info<bool> MAIN_DSP_JIT_PROFILING;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
@@ -300,6 +313,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_COMPRESS_LOGS;
 
 // Main.AutoUpdate
 
@@ -336,6 +350,12 @@ extern const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_ENABLE_PROFILING;
+// If set, the JIT profile is written to this file when emulation stops.
+extern const Info<std::string> MAIN_DEBUG_JIT_PROFILE_OUTPUT;
+// If set, the interpreter records a binary code trace, and the last MAIN_DEBUG_CODE_TRACE_RECORDS
+// instructions are written to this file when emulation stops.
+extern const Info<std::string> MAIN_DEBUG_CODE_TRACE_OUTPUT;
+extern const Info<u32> MAIN_DEBUG_CODE_TRACE_RECORDS;
 
 // Main.BluetoothPassthrough
 
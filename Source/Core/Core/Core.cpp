@@ -422,9 +422,14 @@ static void CpuThread(Core::System& system, const std::optional<std::string>& sa
     }
   }
 
+  system.GetPowerPC().GetCodeTraceRecorder().StartConfiguredTrace(Core::CPUThreadGuard{system});
+
   // Enter CPU run loop. When we leave it - we are done.
   system.GetCPU().Run();
 
+  system.GetJitInterface().WriteConfiguredJitProfile(Core::CPUThreadGuard{system});
+  system.GetPowerPC().GetCodeTraceRecorder().WriteConfiguredTrace(Core::CPUThreadGuard{system});
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
@@ -882,6 +887,8 @@ void Callback_FramePresented(double actual_emulation_speed)
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField(Core::System& system)
 {
+  ::State::UpdateRewindBuffer(system);
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
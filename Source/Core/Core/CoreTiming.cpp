@@ -20,6 +20,7 @@
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -42,8 +43,17 @@ static bool operator<(const Event& left, const Event& right)
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
+static bool IsCancelled(const Event& ev)
+{
+  return ev.generation != ev.type->generation;
+}
+
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
+// Cancelled events are only swept from the whole queue once there are at least this many of them
+// and they outnumber the live ones, which keeps RemoveEvent() amortized O(1).
+static constexpr u32 MIN_CANCELLED_EVENTS_TO_COMPACT = 64;
+
 static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
 }
@@ -102,6 +112,7 @@ void CoreTimingManager::Init()
   m_globals.slice_length = MAX_SLICE_LENGTH;
   m_globals.global_timer = 0;
   m_idled_cycles = 0;
+  m_idle_loop_stats.clear();
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -118,6 +129,8 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
+  LogIdleLoopStats();
+
   std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
@@ -167,6 +180,7 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  CompactEventQueue();
   p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -202,6 +216,14 @@ void CoreTimingManager::DoState(PointerWrap& p)
 
   if (p.IsReadMode())
   {
+    for (auto& [name, event_type] : m_event_types)
+      event_type.queued = 0;
+    for (Event& ev : m_event_queue)
+    {
+      ev.generation = ev.type->generation;
+      ++ev.type->queued;
+    }
+
     // When loading from a save state, we must assume the Event order is random and meaningless.
     // The exact layout of the heap in memory is implementation defined, therefore it is platform
     // and library version specific.
@@ -234,6 +256,39 @@ u64 CoreTimingManager::GetIdleTicks() const
 void CoreTimingManager::ClearPendingEvents()
 {
   m_event_queue.clear();
+  m_cancelled_events = 0;
+  for (auto& [name, event_type] : m_event_types)
+    event_type.queued = 0;
+}
+
+void CoreTimingManager::PushEvent(Event ev)
+{
+  ev.generation = ev.type->generation;
+  ++ev.type->queued;
+  m_event_queue.emplace_back(std::move(ev));
+  std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+}
+
+void CoreTimingManager::PopCancelledEvents()
+{
+  while (!m_event_queue.empty() && IsCancelled(m_event_queue.front()))
+  {
+    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.pop_back();
+    --m_cancelled_events;
+  }
+}
+
+void CoreTimingManager::CompactEventQueue()
+{
+  if (m_cancelled_events == 0)
+    return;
+
+  std::erase_if(m_event_queue, IsCancelled);
+  // Events are totally ordered by (time, fifo_order), so rebuilding the heap doesn't change the
+  // order in which they are executed.
+  std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+  m_cancelled_events = 0;
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -262,8 +317,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -282,14 +336,17 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
+  if (event_type->queued == 0)
+    return;
+
+  ++event_type->generation;
+  m_cancelled_events += event_type->queued;
+  event_type->queued = 0;
 
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
+  if (m_cancelled_events >= MIN_CANCELLED_EVENTS_TO_COMPACT &&
+      m_cancelled_events * 2 > m_event_queue.size())
   {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    CompactEventQueue();
   }
 }
 
@@ -317,8 +374,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    PushEvent(std::move(ev));
   }
 }
 
@@ -345,12 +401,21 @@ void CoreTimingManager::Advance()
     std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
     m_event_queue.pop_back();
 
+    if (IsCancelled(evt))
+    {
+      --m_cancelled_events;
+      continue;
+    }
+    --evt.type->queued;
+
     Throttle(evt.time);
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
   }
 
   m_is_global_timer_sane = false;
 
+  PopCancelledEvents();
+
   // Still events left (scheduled in the future)
   if (!m_event_queue.empty())
   {
@@ -441,6 +506,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 void CoreTimingManager::LogPendingEvents() const
 {
   auto clone = m_event_queue;
+  std::erase_if(clone, IsCancelled);
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -478,12 +544,46 @@ void CoreTimingManager::Idle()
   ppc_state.downcount = 0;
 }
 
+void CoreTimingManager::SkipIdleLoop(u32 loop_address)
+{
+  const s64 idled_cycles = m_idled_cycles;
+  Idle();
+
+  IdleLoopStats& stats = m_idle_loop_stats[loop_address];
+  ++stats.skips;
+  stats.cycles += m_idled_cycles - idled_cycles;
+}
+
+void CoreTimingManager::LogIdleLoopStats() const
+{
+  if (m_idle_loop_stats.empty() || m_globals.global_timer == 0)
+    return;
+
+  std::vector<std::pair<u32, IdleLoopStats>> loops(m_idle_loop_stats.begin(),
+                                                   m_idle_loop_stats.end());
+  std::sort(loops.begin(), loops.end(),
+            [](const auto& a, const auto& b) { return a.second.cycles > b.second.cycles; });
+
+  INFO_LOG_FMT(POWERPC, "Idle skipping in {}: {} of {} cycles ({:.1f}%) in {} busy wait loops",
+               SConfig::GetInstance().GetGameID(), m_idled_cycles, m_globals.global_timer,
+               100.0 * m_idled_cycles / m_globals.global_timer, loops.size());
+
+  constexpr size_t MAX_REPORTED_LOOPS = 10;
+  for (size_t i = 0; i < std::min(loops.size(), MAX_REPORTED_LOOPS); ++i)
+  {
+    const auto& [address, stats] = loops[i];
+    INFO_LOG_FMT(POWERPC, "  {:08x}: skipped {} times, {} cycles", address, stats.skips,
+                 stats.cycles);
+  }
+}
+
 std::string CoreTimingManager::GetScheduledEventsSummary() const
 {
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
   auto clone = m_event_queue;
+  std::erase_if(clone, IsCancelled);
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -537,9 +637,9 @@ void GlobalAdvance()
   Core::System::GetInstance().GetCoreTiming().Advance();
 }
 
-void GlobalIdle()
+void GlobalIdle(u32 loop_address)
 {
-  Core::System::GetInstance().GetCoreTiming().Idle();
+  Core::System::GetInstance().GetCoreTiming().SkipIdleLoop(loop_address);
 }
 
 }  // namespace CoreTiming
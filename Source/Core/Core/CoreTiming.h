@@ -50,6 +50,10 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // Bumped by RemoveEvent. Queued events of this type with an older generation are cancelled.
+  u32 generation = 0;
+  // Number of queued events of this type which have not been cancelled.
+  u32 queued = 0;
 };
 
 struct Event
@@ -58,6 +62,7 @@ struct Event
   u64 fifo_order;
   u64 userdata;
   EventType* type;
+  u32 generation = 0;
 };
 
 enum class FromThread
@@ -71,7 +76,7 @@ enum class FromThread
 
 // helpers until the JIT is updated to use the instance
 void GlobalAdvance();
-void GlobalIdle();
+void GlobalIdle(u32 loop_address);
 
 class CoreTimingManager
 {
@@ -119,6 +124,8 @@ public:
 
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
+  // Idle() on behalf of the busy wait loop starting at loop_address, recording skip statistics.
+  void SkipIdleLoop(u32 loop_address);
 
   // Clear all pending events. This should ONLY be done on exit or state load.
   void ClearPendingEvents();
@@ -164,10 +171,13 @@ private:
 
   // STATE_TO_SAVE
   // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
+  // We don't use std::priority_queue because we need to be able to serialize and unserialize
+  // the queue regardless of its order, which isn't accomodated by the standard adaptor class.
+  // RemoveEvent() doesn't touch the heap. It cancels the events of a type by bumping the type's
+  // generation, and cancelled events are dropped once they reach the front of the queue, or all
+  // at once when they start to outnumber the live ones.
   std::vector<Event> m_event_queue;
+  u32 m_cancelled_events = 0;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -175,6 +185,15 @@ private:
   float m_last_oc_factor = 0.0f;
 
   s64 m_idled_cycles = 0;
+
+  struct IdleLoopStats
+  {
+    u64 skips = 0;
+    u64 cycles = 0;
+  };
+  // Not saved in savestates. Logged per game on shutdown.
+  std::unordered_map<u32, IdleLoopStats> m_idle_loop_stats;
+
   u32 m_fake_dec_start_value = 0;
   u64 m_fake_dec_start_ticks = 0;
 
@@ -200,6 +219,11 @@ private:
 
   void ResetThrottle(s64 cycle);
 
+  void PushEvent(Event ev);
+  void PopCancelledEvents();
+  void CompactEventQueue();
+  void LogIdleLoopStats() const;
+
   int DowncountToCycles(int downcount) const;
   int CyclesToDowncount(int cycles) const;
 };
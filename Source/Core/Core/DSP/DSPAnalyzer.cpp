@@ -60,6 +60,43 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Longest chain of flag-setting instructions allowed between the load and the branch of a
+// polling loop.
+constexpr size_t MAX_POLL_TESTS = 2;
+
+// Hardware registers which are only ever changed from outside the DSP and can be read without
+// side effects (reading DMBL or CMBL acknowledges the mail, for example).
+static bool IsPollableRegister(u16 address)
+{
+  return address == (0xFF00 | DSP_DMBH) || address == (0xFF00 | DSP_CMBH) ||
+         address == (0xFF00 | DSP_DSCR);
+}
+
+// Whether the instruction only sets flags based on its operands.
+static bool IsFlagTest(UDSPInstruction inst)
+{
+  const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+  if (!opcode)
+    return false;
+
+  // The extension of an extended opcode must be a NOP.
+  if (opcode->extended && (inst & 0x00ff) != 0)
+    return false;
+
+  switch (opcode->opcode)
+  {
+  case 0x0280:  // CMPI
+  case 0x02a0:  // ANDF
+  case 0x02c0:  // ANDCF
+  case 0x0600:  // CMPIS
+  case 0x8600:  // TSTAXH
+  case 0xb100:  // TST
+    return true;
+  default:
+    return false;
+  }
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -83,6 +120,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindPollingLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -170,4 +208,54 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindPollingLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  // Matches loops of the form:
+  //   loop: LR(S) $reg, @status
+  //         (up to MAX_POLL_TESTS of CMPI, CMPIS, ANDF, ANDCF, TST, TSTAXH)
+  //         Jcc   loop
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (!IsStartOfInstruction(addr) || IsIdleSkip(addr))
+      continue;
+
+    const UDSPInstruction load = dsp.ReadIMEM(addr);
+    u16 pc = addr;
+    if ((load & 0xf800) == 0x2000)  // LRS, assuming $cr points to the hardware registers
+    {
+      if (!IsPollableRegister(0xFF00 | (load & 0x00ff)))
+        continue;
+      pc += 1;
+    }
+    else if ((load & 0xffe0) == 0x00c0)  // LR
+    {
+      if (!IsPollableRegister(dsp.ReadIMEM(static_cast<u16>(addr + 1))))
+        continue;
+      pc += 2;
+    }
+    else
+    {
+      continue;
+    }
+
+    size_t tests = 0;
+    while (tests < MAX_POLL_TESTS && IsFlagTest(dsp.ReadIMEM(pc)))
+    {
+      pc += GetOpTemplate(dsp.ReadIMEM(pc))->size;
+      tests++;
+    }
+
+    // Conditional jump back to the load; JMP (0x029f) would be an infinite loop.
+    const UDSPInstruction branch = dsp.ReadIMEM(pc);
+    if (tests == 0 || (branch & 0xfff0) != 0x0290 || branch == 0x029f ||
+        dsp.ReadIMEM(static_cast<u16>(pc + 1)) != addr)
+    {
+      continue;
+    }
+
+    INFO_LOG_FMT(DSPLLE, "Polling loop found at {:04x}", addr);
+    m_code_flags[addr] |= CODE_IDLE_SKIP;
+  }
+}
 }  // namespace DSP
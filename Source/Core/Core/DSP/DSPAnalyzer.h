@@ -110,6 +110,11 @@ private:
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
   void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+  // Finds loops within the range [start_addr, end_addr) that do nothing but poll a status
+  // register until it changes, and marks them as idle skips. This catches the mail and DMA wait
+  // loops of ucodes that are not covered by the idle skip signatures.
+  void FindPollingLoops(const SDSP& dsp, u16 start_addr, u16 end_addr);
+
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
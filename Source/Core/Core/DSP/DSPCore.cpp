@@ -420,7 +420,10 @@ bool DSPCore::Initialize(const DSPInitOptions& opts)
 
   // Initialize JIT, if necessary
   if (opts.core_type == DSPInitOptions::CoreType::JIT64)
+  {
     m_dsp_jit = JIT::CreateDSPEmitter(*this);
+    m_dsp_jit->SetProfilingEnabled(opts.jit_profiling);
+  }
 
   m_dsp_cap.reset(opts.capture_logger);
 
@@ -301,6 +301,11 @@ struct DSPInitOptions
   };
   CoreType core_type = CoreType::JIT64;
 
+  // Whether the JIT counts block executions and logs a per-block profile whenever the ucode
+  // changes. Has no effect on the interpreter.
+  // Default: false.
+  bool jit_profiling = false;
+
   // Optional capture logger used to log internal DSP data transfers.
   // Default: dummy implementation, does nothing.
   DSPCaptureLogger* capture_logger;
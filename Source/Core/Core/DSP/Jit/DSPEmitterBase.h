@@ -23,6 +23,7 @@ public:
 
   virtual u16 RunCycles(u16 cycles) = 0;
   virtual void ClearIRAM() = 0;
+  virtual void SetProfilingEnabled(bool enabled) = 0;
 
   virtual void DoState(PointerWrap& p) = 0;
 };
@@ -32,6 +33,7 @@ class DSPEmitterNull final : public DSPEmitter
 public:
   u16 RunCycles(u16) override { return 0; }
   void ClearIRAM() override {}
+  void SetProfilingEnabled(bool) override {}
   void DoState(PointerWrap&) override {}
 };
 
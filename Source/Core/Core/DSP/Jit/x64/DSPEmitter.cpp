@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/BitSet.h"
@@ -28,6 +30,7 @@ namespace DSP::JIT::x64
 constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
 constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+constexpr size_t PROFILE_REPORT_BLOCKS = 20;
 
 DSPEmitter::DSPEmitter(DSPCore& dsp)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
@@ -45,6 +48,7 @@ DSPEmitter::DSPEmitter(DSPCore& dsp)
 
 DSPEmitter::~DSPEmitter()
 {
+  LogProfile();
   FreeCodeSpace();
 }
 
@@ -73,6 +77,8 @@ void DSPEmitter::DoState(PointerWrap& p)
 
 void DSPEmitter::ClearIRAM()
 {
+  LogProfile();
+
   for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
   {
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
@@ -99,6 +105,59 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
   m_dsp_core.DSPState().reset_dspjit_codespace = false;
 }
 
+void DSPEmitter::SetProfilingEnabled(bool enabled)
+{
+  if (enabled == !m_block_runs.empty())
+    return;
+
+  if (enabled)
+    m_block_runs.assign(MAX_BLOCKS, 0);
+  else
+    m_block_runs = {};
+
+  // Already compiled blocks need to be recompiled with (or without) their counters.
+  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::LogProfile()
+{
+  if (m_block_runs.empty())
+    return;
+
+  const auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+
+  // Idle skipping blocks are counted by their real size rather than by the cycles they give up.
+  std::vector<std::pair<u64, u16>> blocks;
+  u64 total_cycles = 0;
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_block_runs[i] == 0)
+      continue;
+
+    const u64 cycles = m_block_runs[i] * std::max<u16>(m_block_size[i], 1);
+    blocks.emplace_back(cycles, static_cast<u16>(i));
+    total_cycles += cycles;
+  }
+
+  if (blocks.empty())
+    return;
+
+  const size_t count = std::min(blocks.size(), PROFILE_REPORT_BLOCKS);
+  std::partial_sort(blocks.begin(), blocks.begin() + count, blocks.end(),
+                    [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  INFO_LOG_FMT(DSPLLE, "JIT profile: {} blocks, {} cycles", blocks.size(), total_cycles);
+  for (size_t i = 0; i < count; i++)
+  {
+    const auto& [cycles, address] = blocks[i];
+    INFO_LOG_FMT(DSPLLE, "  {:#06x}: {:>12} cycles ({:5.2f}%), {:>10} runs x {:>3} insts{}",
+                 address, cycles, 100.0 * cycles / total_cycles, m_block_runs[address],
+                 m_block_size[address], analyzer.IsIdleSkip(address) ? " [idle skip]" : "");
+  }
+
+  std::fill(m_block_runs.begin(), m_block_runs.end(), 0);
+}
+
 static void CheckExceptionsThunk(DSPCore& dsp)
 {
   dsp.CheckExceptions();
@@ -236,6 +295,13 @@ void DSPEmitter::Compile(u16 start_addr)
 
   m_block_link_entry = GetCodePtr();
 
+  if (!m_block_runs.empty())
+  {
+    // RAX is never allocated to a guest register, so it is free at block entry.
+    MOV(64, R(RAX), ImmPtr(&m_block_runs[start_addr]));
+    ADD(64, MatR(RAX), Imm8(1));
+  }
+
   m_compile_pc = start_addr;
   bool fixup_pc = false;
   m_block_size[start_addr] = 0;
@@ -33,6 +33,7 @@ public:
   u16 RunCycles(u16 cycles) override;
   void DoState(PointerWrap& p) override;
   void ClearIRAM() override;
+  void SetProfilingEnabled(bool enabled) override;
 
   // Ext commands
   void l(UDSPInstruction opc);
@@ -203,6 +204,9 @@ private:
   void EmitInstruction(UDSPInstruction inst);
   void ClearIRAMandDSPJITCodespaceReset();
 
+  // Logs the blocks that consumed the most cycles since the last report, then resets the counters.
+  void LogProfile();
+
   void CompileDispatcher();
   Block CompileStub();
   void Compile(u16 start_addr);
@@ -323,6 +327,10 @@ private:
 
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
+  // Number of times each block was entered, either from the dispatcher or through a block link.
+  // Only allocated while profiling is enabled.
+  std::vector<u64> m_block_runs;
+
   u16 m_cycles_left = 0;
 
   // The index of the last stored ext value (compile time).
@@ -116,6 +116,10 @@ void DSPEmitter::WriteBranchExit()
 
 void DSPEmitter::WriteBlockLink(u16 dest)
 {
+  // Idle skipping blocks have to return to the dispatcher to give up the rest of the time slice.
+  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+    return;
+
   // Jump directly to the called block if it has already been compiled.
   if (!(dest >= m_start_address && dest <= m_compile_pc))
   {
@@ -145,11 +149,10 @@ void DSPEmitter::WriteBlockLink(u16 dest)
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Conditional branches are emitted on their taken path only (see ReJitConditional), which
+  // restores the register cache afterwards, so they can be linked just like unconditional ones.
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -192,11 +195,10 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   MOV(16, R(DX), Imm16(m_compile_pc + 2));
   dsp_reg_store_stack(StackRegister::Call);
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Conditional branches are emitted on their taken path only (see ReJitConditional), which
+  // restores the register cache afterwards, so they can be linked just like unconditional ones.
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -15,11 +15,92 @@
 #include "Core/Core.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/MMU.h"
+#include "VideoCommon/VideoEvents.h"
 
 namespace Core
 {
+constexpr int COUNTER_TABLE_BITS = 16;
+constexpr std::size_t COUNTER_TABLE_SIZE = std::size_t{1} << COUNTER_TABLE_BITS;
+constexpr std::size_t MAX_COUNTER_PROBES = 16;
+
+BranchWatch::BranchWatch()
+{
+  m_end_field_hook = VIEndFieldEvent::Register([this] { FlushCounters(); }, "BranchWatch");
+}
+
+static std::size_t GetCounterIndex(const BranchWatchCollectionKey& key, bool is_virtual,
+                                   bool condition)
+{
+  u64 hash = static_cast<const FakeBranchWatchCollectionKey&>(key);
+  hash ^= (u64{key.original_inst.hex} << 2 | u64{is_virtual} << 1 | u64{condition}) *
+          0x9E3779B97F4A7C15;
+  hash *= 0xBF58476D1CE4E5B9;
+  return static_cast<std::size_t>(hash >> (64 - COUNTER_TABLE_BITS));
+}
+
+u64* BranchWatch::GetCounter(u32 origin, u32 destination, UGeckoInstruction inst, bool is_virtual,
+                             bool condition)
+{
+  if (m_counters.empty())
+    m_counters.resize(COUNTER_TABLE_SIZE);
+
+  const BranchWatchCollectionKey key{{origin, destination}, inst};
+  std::size_t index = GetCounterIndex(key, is_virtual, condition);
+  for (std::size_t probe = 0; probe < MAX_COUNTER_PROBES; ++probe)
+  {
+    BranchWatchCounter& counter = m_counters[index];
+    if (!counter.in_use)
+    {
+      counter = {key, is_virtual, condition, true, 0};
+      m_used_counters.push_back(index);
+      return &counter.hits;
+    }
+    if (counter.key == key && counter.is_virtual == is_virtual && counter.condition == condition)
+      return &counter.hits;
+    index = (index + 1) & (COUNTER_TABLE_SIZE - 1);
+  }
+
+  // The caller falls back to calling a Hit function, which records straight to the Collections.
+  return nullptr;
+}
+
+void BranchWatch::FlushCounters()
+{
+  // Emitted code only counts while recording is active, so once the counters have been flushed
+  // after recording was paused, there is nothing left to move.
+  const bool recording_active = m_recording_active;
+  if (!recording_active && !m_counters_pending)
+    return;
+  m_counters_pending = recording_active;
+
+  for (const std::size_t index : m_used_counters)
+  {
+    BranchWatchCounter& counter = m_counters[index];
+    if (counter.hits == 0)
+      continue;
+    GetCollection(counter.is_virtual, counter.condition)[counter.key].total_hits += counter.hits;
+    counter.hits = 0;
+  }
+}
+
+void BranchWatch::ResetCounters()
+{
+  FlushCounters();
+  for (const std::size_t index : m_used_counters)
+    m_counters[index] = {};
+  m_used_counters.clear();
+}
+
+void BranchWatch::DiscardCounters()
+{
+  for (const std::size_t index : m_used_counters)
+    m_counters[index].hits = 0;
+  m_counters_pending = m_recording_active;
+}
+
 void BranchWatch::Clear(const CPUThreadGuard&)
 {
+  DiscardCounters();
   m_selection.clear();
   m_collection_vt.clear();
   m_collection_vf.clear();
@@ -59,7 +140,7 @@ union USnapshotMetadata
   }
 };
 
-void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
+void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file)
 {
   if (!CanSave())
   {
@@ -69,6 +150,8 @@ void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
   if (file == nullptr)
     return;
 
+  FlushCounters();
+
   const auto routine = [&](const Collection& collection, bool is_virtual, bool condition) {
     for (const Collection::value_type& kv : collection)
     {
@@ -94,6 +177,7 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
   if (file == nullptr)
     return;
 
+  // Also drops the hits the JITs counted since the last flush, which belong to the old data.
   Clear(guard);
 
   u32 origin_addr, destin_addr, inst_hex;
@@ -131,6 +215,7 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
 
 void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
 {
+  FlushCounters();
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -169,6 +254,7 @@ void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
 
 void BranchWatch::IsolateNotExecuted(const CPUThreadGuard&)
 {
+  FlushCounters();
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -203,6 +289,7 @@ void BranchWatch::IsolateWasOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  FlushCounters();
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -251,6 +338,7 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  FlushCounters();
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
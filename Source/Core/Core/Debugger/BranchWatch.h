@@ -12,6 +12,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumUtils.h"
+#include "Common/HookableEvent.h"
 #include "Core/PowerPC/Gekko.h"
 
 namespace Core
@@ -37,6 +38,14 @@ struct BranchWatchCollectionValue
   std::size_t total_hits = 0;
   std::size_t hits_snapshot = 0;
 };
+struct BranchWatchCounter
+{
+  BranchWatchCollectionKey key;
+  bool is_virtual;
+  bool condition;
+  bool in_use;
+  u64 hits;
+};
 }  // namespace Core
 
 template <>
@@ -116,13 +125,19 @@ public:
   using Phase = BranchWatchPhase;
   using SelectionInspection = BranchWatchSelectionInspection;
 
+  BranchWatch();
+
   bool GetRecordingActive() const { return m_recording_active; }
-  void SetRecordingActive(bool active) { m_recording_active = active; }
+  void SetRecordingActive(bool active)
+  {
+    m_recording_active = active;
+    m_counters_pending |= active;
+  }
   void Start() { SetRecordingActive(true); }
   void Pause() { SetRecordingActive(false); }
   void Clear(const CPUThreadGuard& guard);
 
-  void Save(const CPUThreadGuard& guard, std::FILE* file) const;
+  void Save(const CPUThreadGuard& guard, std::FILE* file);
   void Load(const CPUThreadGuard& guard, std::FILE* file);
 
   void IsolateHasExecuted(const CPUThreadGuard& guard);
@@ -226,6 +241,19 @@ public:
       HitPhysicalFalse(this, origin, destination, inst.hex);
   }
 
+  // For the JITs, which know the origin and destination of most branches when compiling them.
+  // Returns a counter for the given branch that emitted code can increment by itself while
+  // recording is active, or nullptr if there is no room for more counters. The counters are
+  // preallocated in an open-addressing table, and their hits are moved to the Collections at the
+  // end of every field and before anything reads the Collections under a CPUThreadGuard.
+  u64* GetCounter(u32 origin, u32 destination, UGeckoInstruction inst, bool is_virtual,
+                  bool condition);
+  // Moves the hits of all counters to the Collections. CPU thread only. Returns early while
+  // recording is paused, once the hits counted before the pause have been moved.
+  void FlushCounters();
+  // Frees all counters. Only call this once no emitted code uses them anymore.
+  void ResetCounters();
+
   // The JIT needs this value, but doesn't need to be a full-on friend.
   static constexpr int GetOffsetOfRecordingActive()
   {
@@ -240,6 +268,9 @@ public:
   }
 
 private:
+  // Drops the hits of all counters without moving them to the Collections.
+  void DiscardCounters();
+
   Collection& GetCollectionV(bool condition)
   {
     if (condition)
@@ -269,6 +300,13 @@ private:
   Collection m_collection_pt;  // physical address space | true path
   Collection m_collection_pf;  // physical address space | false path
   Selection m_selection;
+
+  // Allocated on the first call to GetCounter and never resized, as emitted code points into it.
+  std::vector<BranchWatchCounter> m_counters;
+  std::vector<std::size_t> m_used_counters;
+  // Whether the counters may have hits that haven't been moved to the Collections yet.
+  bool m_counters_pending = false;
+  Common::EventHook m_end_field_hook;
 };
 
 #if _M_X86_64
@@ -0,0 +1,414 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Debugger/CodeTraceRecorder.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace Core
+{
+namespace
+{
+constexpr u32 CODE_TRACE_FILE_ID = 0x52544344;  // "DCTR"
+constexpr u32 CODE_TRACE_VERSION = 1;
+
+struct CodeTraceFileHeader
+{
+  u32 file_id;
+  u32 version;
+  u64 first_record;
+  u64 record_count;
+};
+static_assert(sizeof(CodeTraceFileHeader) == 24);
+
+constexpr u32 RegisterRange(u32 first, u32 count)
+{
+  // The string instructions wrap around from r31 to r0.
+  u32 mask = 0;
+  for (u32 i = 0; i < count; ++i)
+    mask |= 1u << ((first + i) % 32);
+  return mask;
+}
+
+u32 GetQuantizedSize(EQuantizeType type)
+{
+  switch (type)
+  {
+  case QUANTIZE_U8:
+  case QUANTIZE_S8:
+    return 1;
+  case QUANTIZE_U16:
+  case QUANTIZE_S16:
+    return 2;
+  default:
+    return 4;
+  }
+}
+
+u32 GetPairedSize(const PowerPC::PowerPCState& ppc_state, u32 gqr_index, bool single, bool store)
+{
+  const UGQR gqr(GQR(ppc_state, gqr_index));
+  const u32 size = GetQuantizedSize(store ? gqr.st_type.Value() : gqr.ld_type.Value());
+  return single ? size : size * 2;
+}
+
+bool IsLoadMultiple(UGeckoInstruction inst)
+{
+  return inst.OPCD == 46 || (inst.OPCD == 31 && (inst.SUBOP10 == 533 || inst.SUBOP10 == 597));
+}
+
+bool IsStoreMultiple(UGeckoInstruction inst)
+{
+  return inst.OPCD == 47 || (inst.OPCD == 31 && (inst.SUBOP10 == 661 || inst.SUBOP10 == 725));
+}
+}  // namespace
+
+CodeTraceMemoryAccess GetCodeTraceMemoryAccess(const PowerPC::PowerPCState& ppc_state,
+                                               UGeckoInstruction inst)
+{
+  const u32 ra0 = inst.RA == 0 ? 0 : ppc_state.gpr[inst.RA];
+  const u32 d_form = ra0 + static_cast<u32>(inst.SIMM_16);
+  const u32 x_form = ra0 + ppc_state.gpr[inst.RB];
+
+  switch (inst.OPCD)
+  {
+  case 32:  // lwz
+  case 33:  // lwzu
+  case 48:  // lfs
+  case 49:  // lfsu
+    return {d_form, 4, CODE_TRACE_LOAD};
+  case 34:  // lbz
+  case 35:  // lbzu
+    return {d_form, 1, CODE_TRACE_LOAD};
+  case 40:  // lhz
+  case 41:  // lhzu
+  case 42:  // lha
+  case 43:  // lhau
+    return {d_form, 2, CODE_TRACE_LOAD};
+  case 50:  // lfd
+  case 51:  // lfdu
+    return {d_form, 8, CODE_TRACE_LOAD};
+  case 36:  // stw
+  case 37:  // stwu
+  case 52:  // stfs
+  case 53:  // stfsu
+    return {d_form, 4, CODE_TRACE_STORE};
+  case 38:  // stb
+  case 39:  // stbu
+    return {d_form, 1, CODE_TRACE_STORE};
+  case 44:  // sth
+  case 45:  // sthu
+    return {d_form, 2, CODE_TRACE_STORE};
+  case 54:  // stfd
+  case 55:  // stfdu
+    return {d_form, 8, CODE_TRACE_STORE};
+  case 46:  // lmw
+    return {d_form, 4 * (32 - inst.RD), CODE_TRACE_LOAD};
+  case 47:  // stmw
+    return {d_form, 4 * (32 - inst.RS), CODE_TRACE_STORE};
+  case 56:  // psq_l
+  case 57:  // psq_lu
+    return {ra0 + static_cast<u32>(inst.SIMM_12), GetPairedSize(ppc_state, inst.I, inst.W, false),
+            CODE_TRACE_LOAD};
+  case 60:  // psq_st
+  case 61:  // psq_stu
+    return {ra0 + static_cast<u32>(inst.SIMM_12), GetPairedSize(ppc_state, inst.I, inst.W, true),
+            CODE_TRACE_STORE};
+  case 4:
+    switch (inst.SUBOP6)
+    {
+    case 6:   // psq_lx
+    case 38:  // psq_lux
+      return {x_form, GetPairedSize(ppc_state, inst.Ix, inst.Wx, false), CODE_TRACE_LOAD};
+    case 7:   // psq_stx
+    case 39:  // psq_stux
+      return {x_form, GetPairedSize(ppc_state, inst.Ix, inst.Wx, true), CODE_TRACE_STORE};
+    }
+    if (inst.SUBOP10 == 1014)  // dcbz_l
+      return {x_form & ~31u, 32, CODE_TRACE_STORE};
+    return {};
+  case 31:
+    switch (inst.SUBOP10)
+    {
+    case 20:   // lwarx
+    case 23:   // lwzx
+    case 55:   // lwzux
+    case 310:  // eciwx
+    case 534:  // lwbrx
+    case 535:  // lfsx
+    case 567:  // lfsux
+      return {x_form, 4, CODE_TRACE_LOAD};
+    case 87:   // lbzx
+    case 119:  // lbzux
+      return {x_form, 1, CODE_TRACE_LOAD};
+    case 279:  // lhzx
+    case 311:  // lhzux
+    case 343:  // lhax
+    case 375:  // lhaux
+    case 790:  // lhbrx
+      return {x_form, 2, CODE_TRACE_LOAD};
+    case 599:  // lfdx
+    case 631:  // lfdux
+      return {x_form, 8, CODE_TRACE_LOAD};
+    case 150:  // stwcx.
+    case 151:  // stwx
+    case 183:  // stwux
+    case 438:  // ecowx
+    case 662:  // stwbrx
+    case 663:  // stfsx
+    case 695:  // stfsux
+    case 983:  // stfiwx
+      return {x_form, 4, CODE_TRACE_STORE};
+    case 215:  // stbx
+    case 247:  // stbux
+      return {x_form, 1, CODE_TRACE_STORE};
+    case 407:  // sthx
+    case 439:  // sthux
+    case 918:  // sthbrx
+      return {x_form, 2, CODE_TRACE_STORE};
+    case 727:  // stfdx
+    case 759:  // stfdux
+      return {x_form, 8, CODE_TRACE_STORE};
+    case 533:  // lswx
+      return {x_form, static_cast<u8>(ppc_state.xer_stringctrl), CODE_TRACE_LOAD};
+    case 661:  // stswx
+      return {x_form, static_cast<u8>(ppc_state.xer_stringctrl), CODE_TRACE_STORE};
+    case 597:  // lswi
+      return {ra0, inst.NB == 0 ? 32u : inst.NB, CODE_TRACE_LOAD};
+    case 725:  // stswi
+      return {ra0, inst.NB == 0 ? 32u : inst.NB, CODE_TRACE_STORE};
+    case 1014:  // dcbz
+      return {x_form & ~31u, 32, CODE_TRACE_STORE};
+    case 54:   // dcbst
+    case 86:   // dcbf
+    case 470:  // dcbi
+    case 982:  // icbi
+      return {x_form & ~31u, 32, CODE_TRACE_CACHE};
+    }
+    return {};
+  default:
+    return {};
+  }
+}
+
+CodeTraceRegisters GetCodeTraceRegistersRead(const CodeTraceRecord& record)
+{
+  const UGeckoInstruction inst(record.instruction);
+  if (!PPCTables::IsValidInstruction(inst, record.pc))
+    return {};
+
+  const u64 flags = PPCTables::GetOpInfo(inst, record.pc)->flags;
+  CodeTraceRegisters registers;
+  if ((flags & FL_IN_A) != 0 || ((flags & FL_IN_A0) != 0 && inst.RA != 0))
+    registers.gprs |= 1u << inst.RA;
+  if ((flags & FL_IN_B) != 0)
+    registers.gprs |= 1u << inst.RB;
+  if ((flags & FL_IN_C) != 0)
+    registers.gprs |= 1u << inst.RC;
+  if ((flags & FL_IN_S) != 0)
+    registers.gprs |= 1u << inst.RS;
+  if (IsStoreMultiple(inst))
+    registers.gprs |= RegisterRange(inst.RS, (record.memory_size + 3) / 4);
+
+  if ((flags & FL_IN_FLOAT_A) != 0)
+    registers.fprs |= 1u << inst.FA;
+  if ((flags & FL_IN_FLOAT_B) != 0)
+    registers.fprs |= 1u << inst.FB;
+  if ((flags & FL_IN_FLOAT_C) != 0)
+    registers.fprs |= 1u << inst.FC;
+  if ((flags & FL_IN_FLOAT_S) != 0)
+    registers.fprs |= 1u << inst.FS;
+  if ((flags & FL_IN_FLOAT_D) != 0)
+    registers.fprs |= 1u << inst.FD;
+
+  return registers;
+}
+
+CodeTraceSlice SliceCodeTrace(const CodeTraceLog& log, std::size_t end, bool is_fpr, u32 index,
+                              std::size_t max_records)
+{
+  CodeTraceSlice slice;
+  u32& live_gprs = slice.live_registers.gprs;
+  u32& live_fprs = slice.live_registers.fprs;
+  std::set<u32>& live_memory = slice.live_memory;
+  live_gprs = is_fpr ? 0 : 1u << index;
+  live_fprs = is_fpr ? 1u << index : 0;
+
+  for (std::size_t i = end; i-- > 0 && slice.records.size() < max_records;)
+  {
+    const CodeTraceRecord& record = log.records[i];
+
+    const bool writes_register =
+        (record.gprs_written & live_gprs) != 0 || (record.fprs_written & live_fprs) != 0;
+    bool writes_memory = false;
+    if ((record.flags & CODE_TRACE_STORE) != 0 && !live_memory.empty())
+    {
+      for (u32 offset = 0; offset < record.memory_size; ++offset)
+        writes_memory |= live_memory.erase(record.memory_address + offset) != 0;
+    }
+
+    if (!writes_register && !writes_memory)
+      continue;
+
+    slice.records.push_back(i);
+
+    live_gprs &= ~record.gprs_written;
+    live_fprs &= ~record.fprs_written;
+    const CodeTraceRegisters read = GetCodeTraceRegistersRead(record);
+    live_gprs |= read.gprs;
+    live_fprs |= read.fprs;
+
+    if (writes_register && (record.flags & CODE_TRACE_LOAD) != 0)
+    {
+      for (u32 offset = 0; offset < record.memory_size; ++offset)
+        live_memory.insert(record.memory_address + offset);
+    }
+
+    if (live_gprs == 0 && live_fprs == 0 && live_memory.empty())
+      break;
+  }
+
+  return slice;
+}
+
+std::optional<CodeTraceLog> LoadCodeTrace(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  CodeTraceFileHeader header;
+  if (!file.ReadArray(&header, 1) || header.file_id != CODE_TRACE_FILE_ID ||
+      header.version != CODE_TRACE_VERSION)
+  {
+    return std::nullopt;
+  }
+
+  if (header.record_count > (file.GetSize() - sizeof(header)) / sizeof(CodeTraceRecord))
+    return std::nullopt;
+
+  CodeTraceLog log;
+  log.first_record = header.first_record;
+  log.records.resize(header.record_count);
+  if (!file.ReadArray(log.records.data(), log.records.size()))
+    return std::nullopt;
+
+  return log;
+}
+
+void CodeTraceRecorder::Start(const CPUThreadGuard&, std::size_t capacity)
+{
+  m_records.assign(std::bit_ceil(std::max<std::size_t>(capacity, 1)), CodeTraceRecord{});
+  m_mask = m_records.size() - 1;
+  m_record_count = 0;
+  m_recording = true;
+}
+
+void CodeTraceRecorder::Stop(const CPUThreadGuard&)
+{
+  m_recording = false;
+}
+
+bool CodeTraceRecorder::Save(const CPUThreadGuard&, const std::string& path) const
+{
+  File::IOFile file(path, "wb");
+  if (!file)
+    return false;
+
+  const u64 count = std::min<u64>(m_record_count, m_records.size());
+  const CodeTraceFileHeader header{CODE_TRACE_FILE_ID, CODE_TRACE_VERSION, m_record_count - count,
+                                   count};
+  if (!file.WriteArray(&header, 1))
+    return false;
+
+  // Once the ring has wrapped around, the oldest record is the one that will be overwritten next.
+  const std::size_t oldest = static_cast<std::size_t>(m_record_count - count) & m_mask;
+  const std::size_t first_part = std::min<std::size_t>(count, m_records.size() - oldest);
+  return file.WriteArray(m_records.data() + oldest, first_part) &&
+         file.WriteArray(m_records.data(), count - first_part);
+}
+
+void CodeTraceRecorder::StartConfiguredTrace(const CPUThreadGuard& guard)
+{
+  const std::string path = Config::Get(Config::MAIN_DEBUG_CODE_TRACE_OUTPUT);
+  if (path.empty())
+    return;
+
+  if (Config::Get(Config::MAIN_CPU_CORE) != PowerPC::CPUCore::Interpreter)
+  {
+    WARN_LOG_FMT(POWERPC, "The code trace for {} only records instructions that are stepped by the "
+                          "interpreter, since the JIT is in use",
+                 path);
+  }
+
+  Start(guard, Config::Get(Config::MAIN_DEBUG_CODE_TRACE_RECORDS));
+}
+
+void CodeTraceRecorder::WriteConfiguredTrace(const CPUThreadGuard& guard)
+{
+  const std::string path = Config::Get(Config::MAIN_DEBUG_CODE_TRACE_OUTPUT);
+  if (path.empty() || !m_recording)
+    return;
+
+  Stop(guard);
+  if (!Save(guard, path))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to write the code trace to {}", path);
+    return;
+  }
+
+  NOTICE_LOG_FMT(POWERPC, "Wrote the last {} of {} executed instructions to {}",
+                 std::min<u64>(m_record_count, m_records.size()), m_record_count, path);
+}
+
+void CodeTraceRecorder::Record(const PowerPC::PowerPCState& ppc_state, UGeckoInstruction inst,
+                               const GekkoOPInfo& opinfo)
+{
+  CodeTraceRecord& record = m_pending_record;
+
+  record.pc = ppc_state.pc;
+  record.instruction = inst.hex;
+  record.gprs_written = 0;
+  record.fprs_written = 0;
+  record.memory_address = 0;
+  record.memory_size = 0;
+  record.flags = 0;
+
+  const u64 flags = opinfo.flags;
+  if ((flags & FL_LOADSTORE) != 0)
+  {
+    const CodeTraceMemoryAccess access = GetCodeTraceMemoryAccess(ppc_state, inst);
+    record.memory_address = access.address;
+    record.memory_size = static_cast<u16>(access.size);
+    record.flags = access.flags;
+    if (access.flags != 0 && ppc_state.msr.DR)
+      record.flags |= CODE_TRACE_TRANSLATED;
+
+    if (IsLoadMultiple(inst))
+      record.gprs_written |= RegisterRange(inst.RD, (access.size + 3) / 4);
+  }
+
+  if ((flags & FL_OUT_D) != 0)
+    record.gprs_written |= 1u << inst.RD;
+  if ((flags & FL_OUT_A) != 0)
+    record.gprs_written |= 1u << inst.RA;
+  if ((flags & FL_OUT_FLOAT_D) != 0)
+    record.fprs_written |= 1u << inst.FD;
+
+  if ((flags & FL_SET_CRx) != 0 || ((flags & (FL_RC_BIT | FL_RC_BIT_F)) != 0 && inst.Rc))
+    record.flags |= CODE_TRACE_SET_CR;
+  if ((flags & FL_SET_CA) != 0 || ((flags & FL_SET_OE) != 0 && inst.OE))
+    record.flags |= CODE_TRACE_SET_XER;
+}
+}  // namespace Core
@@ -0,0 +1,141 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/Gekko.h"
+
+struct GekkoOPInfo;
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+namespace PowerPC
+{
+struct PowerPCState;
+}
+
+namespace Core
+{
+enum CodeTraceFlags : u8
+{
+  CODE_TRACE_LOAD = 1 << 0,        // Read memory_size bytes at memory_address.
+  CODE_TRACE_STORE = 1 << 1,       // Wrote memory_size bytes at memory_address.
+  CODE_TRACE_CACHE = 1 << 2,       // Operated on the cache block at memory_address.
+  CODE_TRACE_SET_CR = 1 << 3,      // Changed the condition register.
+  CODE_TRACE_SET_XER = 1 << 4,     // Changed the carry or overflow bits of XER.
+  CODE_TRACE_TRANSLATED = 1 << 5,  // memory_address is an effective address (MSR.DR was set).
+};
+
+// One executed instruction. The records are written to trace files as they are, in host byte order.
+struct CodeTraceRecord
+{
+  u32 pc;
+  u32 instruction;
+  // Bit n is set if the instruction wrote rn or fn.
+  u32 gprs_written;
+  u32 fprs_written;
+  u32 memory_address;
+  u16 memory_size;
+  u8 flags;
+  u8 padding;
+};
+static_assert(sizeof(CodeTraceRecord) == 24);
+
+struct CodeTraceRegisters
+{
+  u32 gprs = 0;
+  u32 fprs = 0;
+};
+
+struct CodeTraceMemoryAccess
+{
+  u32 address = 0;
+  u32 size = 0;
+  // CODE_TRACE_LOAD, CODE_TRACE_STORE or CODE_TRACE_CACHE, or 0 if no memory is accessed.
+  u8 flags = 0;
+};
+
+struct CodeTraceLog
+{
+  // Sequence number of the first record. The records before it were overwritten in the ring.
+  u64 first_record = 0;
+  std::vector<CodeTraceRecord> records;
+};
+
+struct CodeTraceSlice
+{
+  // Indices of the records that the value depends on, newest first.
+  std::vector<std::size_t> records;
+  // What the value still depends on before the first record that was looked at.
+  CodeTraceRegisters live_registers;
+  std::set<u32> live_memory;
+};
+
+// Decodes the memory an instruction is about to access. This has to run before the instruction,
+// since the update forms overwrite rA.
+CodeTraceMemoryAccess GetCodeTraceMemoryAccess(const PowerPC::PowerPCState& ppc_state,
+                                               UGeckoInstruction inst);
+
+// The registers an instruction read, decoded from its instruction word. Condition, link, count and
+// other special registers aren't included.
+CodeTraceRegisters GetCodeTraceRegistersRead(const CodeTraceRecord& record);
+
+// Walks backwards from the record before end and collects up to max_records records that the value
+// of the given register depends on, following loads to the stores that wrote the loaded memory.
+CodeTraceSlice SliceCodeTrace(const CodeTraceLog& log, std::size_t end, bool is_fpr, u32 index,
+                              std::size_t max_records);
+
+std::optional<CodeTraceLog> LoadCodeTrace(const std::string& path);
+
+// Records every instruction the interpreter executes into a fixed-size ring, so that the last
+// records can be saved when something interesting happens. The JITs don't record anything.
+class CodeTraceRecorder
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+  // The capacity is rounded up to a power of two.
+  void Start(const CPUThreadGuard& guard, std::size_t capacity = DEFAULT_CAPACITY);
+  void Stop(const CPUThreadGuard& guard);
+  bool IsRecording() const { return m_recording; }
+
+  // Number of instructions recorded since Start, including the ones that were overwritten.
+  u64 GetRecordCount() const { return m_record_count; }
+
+  bool Save(const CPUThreadGuard& guard, const std::string& path) const;
+
+  // Starts recording if MAIN_DEBUG_CODE_TRACE_OUTPUT is set.
+  void StartConfiguredTrace(const CPUThreadGuard& guard);
+  // Saves to the file set in MAIN_DEBUG_CODE_TRACE_OUTPUT, if any, and stops recording.
+  void WriteConfiguredTrace(const CPUThreadGuard& guard);
+
+  // Called by the interpreter before it executes an instruction. The record is only kept once
+  // CommitRecord is called, so that instructions which raise an exception aren't recorded.
+  void Record(const PowerPC::PowerPCState& ppc_state, UGeckoInstruction inst,
+              const GekkoOPInfo& opinfo);
+  // Called by the interpreter after the instruction passed to Record completed.
+  void CommitRecord()
+  {
+    m_records[static_cast<std::size_t>(m_record_count) & m_mask] = m_pending_record;
+    ++m_record_count;
+  }
+
+private:
+  std::vector<CodeTraceRecord> m_records;
+  // Kept out of the ring until the instruction completes, so that it can't overwrite the oldest
+  // record.
+  CodeTraceRecord m_pending_record{};
+  std::size_t m_mask = 0;
+  u64 m_record_count = 0;
+  bool m_recording = false;
+};
+}  // namespace Core
@@ -5,22 +5,42 @@
 
 #include <algorithm>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+// Compressed files were added in version 6.
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSION = 6;
+
+constexpr int ZSTD_COMPRESSION_LEVEL = 3;
+
+enum class Compression : u8
+{
+  None = 0,
+  // Every FIFO data and memory update block is preceded by its stored size as a u32. Blocks whose
+  // stored size equals their size are stored as is, and the others are compressed with zstd.
+  Zstd = 1,
+};
 
 #pragma pack(push, 1)
 
@@ -46,7 +66,9 @@ struct FileHeader
   // will crash and burn with mismatched settings.  See PR #8722.
   u32 mem1_size;
   u32 mem2_size;
-  u8 reserved[32];
+  // Only valid from version 6. Older versions left it uninitialized.
+  Compression compression;
+  u8 reserved[31];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
@@ -101,9 +123,177 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  return static_cast<u32>(m_file ? m_frame_index.size() : m_Frames.size());
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (!m_file)
+    return m_Frames[frame];
+
+  std::lock_guard lk(m_file_lock);
+
+  CachedFrame& cached = m_frame_cache[frame % FRAME_CACHE_SIZE];
+  if (cached.info && cached.frame == frame)
+    return cached.info;
+
+  auto info = std::make_shared<FifoFrameInfo>();
+  if (!ReadFrame(m_frame_index[frame], *info))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read frame {} of the DFF file", frame);
+    *info = {};
+  }
+
+  cached.frame = frame;
+  cached.info = std::move(info);
+  return cached.info;
 }
 
+std::vector<MemoryUpdate> FifoDataFile::GetFinalMemoryUpdates() const
+{
+  struct UpdateSource
+  {
+    u32 fifo_position;
+    u32 address;
+    u32 size;
+    MemoryUpdate::Type type;
+    // Loaded files read the data from this offset, and recorded ones copy it from the update.
+    u64 data_offset;
+    const MemoryUpdate* recorded;
+  };
+
+  std::lock_guard lk(m_file_lock);
+
+  std::vector<UpdateSource> sources;
+  if (m_file)
+  {
+    std::vector<FileMemoryUpdate> src_updates;
+    for (const FileFrameInfo& frame : m_frame_index)
+    {
+      src_updates.resize(frame.numMemoryUpdates);
+      m_file->Seek(frame.memoryUpdatesOffset, File::SeekOrigin::Begin);
+      if (!m_file->ReadArray(src_updates.data(), src_updates.size()))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to read the memory updates of the DFF file");
+        return {};
+      }
+
+      for (const FileMemoryUpdate& src : src_updates)
+      {
+        sources.push_back({src.fifoPosition, src.address, src.dataSize,
+                           static_cast<MemoryUpdate::Type>(src.type), src.dataOffset, nullptr});
+      }
+    }
+  }
+  else
+  {
+    for (const std::shared_ptr<const FifoFrameInfo>& frame : m_Frames)
+    {
+      for (const MemoryUpdate& update : frame->memoryUpdates)
+      {
+        sources.push_back({update.fifoPosition, update.address,
+                           static_cast<u32>(update.data.size()), update.type, 0, &update});
+      }
+    }
+  }
+
+  std::map<std::pair<u32, u32>, size_t> last_updates;
+  for (size_t i = 0; i < sources.size(); ++i)
+    last_updates[{sources[i].address, sources[i].size}] = i;
+
+  std::vector<MemoryUpdate> updates;
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    const UpdateSource& source = sources[i];
+    if (last_updates[{source.address, source.size}] != i)
+      continue;
+
+    MemoryUpdate& update = updates.emplace_back();
+    update.fifoPosition = source.fifo_position;
+    update.address = source.address;
+    update.type = source.type;
+    if (source.recorded)
+    {
+      update.data = source.recorded->data;
+    }
+    else
+    {
+      update.data.resize(source.size);
+      if (!ReadData(source.data_offset, update.data.data(), source.size))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to read the memory updates of the DFF file");
+        return {};
+      }
+    }
+  }
+
+  return updates;
+}
+
+namespace
+{
+// Appends FIFO data and memory update blocks to a DFF file being saved.
+class DataWriter
+{
+public:
+  DataWriter(File::IOFile& file, bool compress) : m_file(file), m_compress(compress) {}
+
+  u64 Write(const u8* data, u32 size)
+  {
+    m_file.Seek(0, File::SeekOrigin::End);
+    const u64 offset = m_file.Tell();
+
+    if (!m_compress)
+    {
+      m_file.WriteBytes(data, size);
+      return offset;
+    }
+
+    m_buffer.resize(ZSTD_compressBound(size));
+    const size_t compressed_size =
+        ZSTD_compress(m_buffer.data(), m_buffer.size(), data, size, ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(compressed_size) || compressed_size >= size)
+    {
+      m_file.WriteArray(&size, 1);
+      m_file.WriteBytes(data, size);
+    }
+    else
+    {
+      const u32 stored_size = static_cast<u32>(compressed_size);
+      m_file.WriteArray(&stored_size, 1);
+      m_file.WriteBytes(m_buffer.data(), compressed_size);
+    }
+    return offset;
+  }
+
+  // Memory updates often upload the same data in many frames, so they are only written once and
+  // identical updates point to the same block.
+  u64 WriteDeduplicated(const std::vector<u8>& data)
+  {
+    const XXH128_hash_t hash = XXH3_128bits(data.data(), data.size());
+    const auto key = std::make_tuple(hash.low64, hash.high64, data.size());
+    const auto it = m_written_blocks.find(key);
+    if (it != m_written_blocks.end())
+      return it->second;
+
+    const u64 offset = Write(data.data(), static_cast<u32>(data.size()));
+    m_written_blocks.emplace(key, offset);
+    return offset;
+  }
+
+private:
+  File::IOFile& m_file;
+  bool m_compress;
+  std::vector<u8> m_buffer;
+  std::map<std::tuple<u64, u64, size_t>, u64> m_written_blocks;
+};
+}  // namespace
+
 bool FifoDataFile::Save(const std::string& filename)
 {
   File::IOFile file;
@@ -113,9 +303,12 @@ bool FifoDataFile::Save(const std::string& filename)
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
+  const u32 frame_count = GetFrameCount();
+  const bool compress = Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS);
+
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frame_count * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -133,11 +326,13 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteArray(m_TexMem);
 
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
   // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+  if (compress)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSION;
+  else if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
@@ -158,9 +353,10 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frame_count;
 
   header.flags = m_Flags;
+  header.compression = compress ? Compression::Zstd : Compression::None;
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
@@ -170,25 +366,43 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
+  DataWriter writer(file, compress);
+  std::vector<FileMemoryUpdate> memory_updates;
+
   // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  for (u32 i = 0; i < frame_count; ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+    const std::shared_ptr<const FifoFrameInfo> srcFrame = GetFrame(i);
 
     // Write FIFO data
+    const u64 dataOffset =
+        writer.Write(srcFrame->fifoData.data(), static_cast<u32>(srcFrame->fifoData.size()));
+
+    memory_updates.resize(srcFrame->memoryUpdates.size());
+    for (size_t j = 0; j < memory_updates.size(); ++j)
+    {
+      const MemoryUpdate& srcUpdate = srcFrame->memoryUpdates[j];
+      FileMemoryUpdate& dstUpdate = memory_updates[j];
+      dstUpdate = {};
+      dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+      dstUpdate.address = srcUpdate.address;
+      dstUpdate.dataOffset = writer.WriteDeduplicated(srcUpdate.data);
+      dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+      dstUpdate.type = static_cast<u8>(srcUpdate.type);
+    }
+
+    // Write memory update list
     file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    const u64 memoryUpdatesOffset = file.Tell();
+    file.WriteArray(memory_updates.data(), memory_updates.size());
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
+    FileFrameInfo dstFrame{};
+    dstFrame.fifoDataSize = static_cast<u32>(srcFrame->fifoData.size());
     dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+    dstFrame.fifoStart = srcFrame->fifoStart;
+    dstFrame.fifoEnd = srcFrame->fifoEnd;
     dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+    dstFrame.numMemoryUpdates = static_cast<u32>(memory_updates.size());
 
     // Write frame info
     u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
@@ -204,8 +418,8 @@ bool FifoDataFile::Save(const std::string& filename)
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
+  auto file_ptr = std::make_unique<File::IOFile>(filename, "rb");
+  File::IOFile& file = *file_ptr;
   if (!file)
     return nullptr;
 
@@ -248,6 +462,16 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     header.mem2_size = Memory::MEM2_SIZE_RETAIL;
   }
 
+  if (header.file_version < 6)
+    header.compression = Compression::None;
+
+  if (header.compression != Compression::None && header.compression != Compression::Zstd)
+  {
+    CriticalAlertFmtT("DFF file uses an unknown compression method ({0})",
+                      static_cast<u8>(header.compression));
+    return nullptr;
+  }
+
   auto dataFile = std::make_unique<FifoDataFile>();
 
   dataFile->m_Flags = header.flags;
@@ -316,32 +540,27 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+  // Only read the frame list. The frames themselves are read when they are needed, so that
+  // opening long captures is fast and does not need memory for all of their frames.
+  const u64 file_size = file.GetSize();
+  dataFile->m_frame_index.resize(header.frameCount);
+  file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+  if (!file.ReadArray(dataFile->m_frame_index.data(), dataFile->m_frame_index.size()))
+    return panic_failed_to_read();
 
-    if (!file.IsGood())
+  for (const FileFrameInfo& frame : dataFile->m_frame_index)
+  {
+    if (frame.fifoDataOffset > file_size ||
+        frame.memoryUpdatesOffset + u64{frame.numMemoryUpdates} * sizeof(FileMemoryUpdate) >
+            file_size)
+    {
       return panic_failed_to_read();
-
-    dataFile->AddFrame(dstFrame);
+    }
   }
 
+  dataFile->m_compressed = header.compression == Compression::Zstd;
+  dataFile->m_file = std::move(file_ptr);
+
   return dataFile;
 }
 
@@ -364,56 +583,52 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+bool FifoDataFile::ReadFrame(const FileFrameInfo& src_frame, FifoFrameInfo& frame) const
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
+  frame.fifoStart = src_frame.fifoStart;
+  frame.fifoEnd = src_frame.fifoEnd;
+  frame.fifoData.resize(src_frame.fifoDataSize);
+  if (!ReadData(src_frame.fifoDataOffset, frame.fifoData.data(), src_frame.fifoDataSize))
+    return false;
 
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
+  std::vector<FileMemoryUpdate> src_updates(src_frame.numMemoryUpdates);
+  m_file->Seek(src_frame.memoryUpdatesOffset, File::SeekOrigin::Begin);
+  if (!m_file->ReadArray(src_updates.data(), src_updates.size()))
+    return false;
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = static_cast<u8>(srcUpdate.type);
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+  frame.memoryUpdates.resize(src_updates.size());
+  for (size_t i = 0; i < src_updates.size(); ++i)
+  {
+    const FileMemoryUpdate& src_update = src_updates[i];
+    MemoryUpdate& update = frame.memoryUpdates[i];
+    update.address = src_update.address;
+    update.fifoPosition = src_update.fifoPosition;
+    update.data.resize(src_update.dataSize);
+    update.type = static_cast<MemoryUpdate::Type>(src_update.type);
+
+    if (!ReadData(src_update.dataOffset, update.data.data(), src_update.dataSize))
+      return false;
   }
 
-  return updateListOffset;
+  return true;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+bool FifoDataFile::ReadData(u64 offset, u8* data, u32 size) const
 {
-  memUpdates.resize(numUpdates);
+  m_file->Seek(offset, File::SeekOrigin::Begin);
+  if (!m_compressed)
+    return m_file->ReadBytes(data, size);
 
-  for (u32 i = 0; i < numUpdates; ++i)
-  {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
-
-    MemoryUpdate& dstUpdate = memUpdates[i];
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
-    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
-
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
-  }
+  u32 stored_size;
+  if (!m_file->ReadArray(&stored_size, 1))
+    return false;
+  if (stored_size == size)
+    return m_file->ReadBytes(data, size);
+
+  m_read_buffer.resize(stored_size);
+  if (!m_file->ReadBytes(m_read_buffer.data(), stored_size))
+    return false;
+
+  const size_t decompressed_size = ZSTD_decompress(data, size, m_read_buffer.data(), stored_size);
+  return !ZSTD_isError(decompressed_size) && decompressed_size == size;
 }
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,8 @@ namespace File
 class IOFile;
 }
 
+struct FileFrameInfo;
+
 struct MemoryUpdate
 {
   enum class Type : u8
@@ -73,8 +76,16 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Frames of loaded files are read from the file when they are first requested, and only the
+  // most recently used ones are kept in memory. Hold on to the returned frame while using it.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Returns the memory updates of all frames in order, except for those that a later update of
+  // the same address and size overwrites. Writing them has the same effect as writing all memory
+  // updates, but only needs to read the data of the remaining ones.
+  std::vector<MemoryUpdate> GetFinalMemoryUpdates() const;
+  // Identical memory updates are always stored once. If MAIN_FIFOPLAYER_COMPRESS_LOGS is set, the
+  // FIFO data and memory updates are also compressed with zstd, which older versions cannot load.
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -85,14 +96,22 @@ private:
     FLAG_IS_WII = 1
   };
 
+  static constexpr u32 FRAME_CACHE_SIZE = 8;
+
+  struct CachedFrame
+  {
+    u32 frame = 0;
+    std::shared_ptr<const FifoFrameInfo> info;
+  };
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  // These must be called with m_file_lock held.
+  bool ReadFrame(const FileFrameInfo& src_frame, FifoFrameInfo& frame) const;
+  bool ReadData(u64 offset, u8* data, u32 size) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +124,14 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Recorded frames. Loaded files use m_frame_index instead.
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+
+  std::unique_ptr<File::IOFile> m_file;
+  std::vector<FileFrameInfo> m_frame_index;
+  bool m_compressed = false;
+
+  mutable std::mutex m_file_lock;
+  mutable std::array<CachedFrame, FRAME_CACHE_SIZE> m_frame_cache;
+  mutable std::vector<u8> m_read_buffer;
 };
@@ -33,12 +33,12 @@
 // TODO: Move texMem somewhere else so this isn't an issue.
 #include "VideoCommon/TextureDecoder.h"
 
-namespace
-{
+// Splits frames into parts for the object range. Frames have to be analyzed in order, as the
+// commands of a frame are decoded with the CP state left by the frames before it.
 class FifoPlaybackAnalyzer : public OpcodeDecoder::Callback
 {
 public:
-  static void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frame_info);
+  void AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed);
 
   explicit FifoPlaybackAnalyzer(const u32* cpmem) : m_cpmem(cpmem) {}
 
@@ -73,60 +73,49 @@ public:
   CPState m_cpmem;
 };
 
-void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
-                                         std::vector<AnalyzedFrameInfo>& frame_info)
+void FifoPlaybackAnalyzer::AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed)
 {
-  FifoPlaybackAnalyzer analyzer(file->GetCPMem());
-  frame_info.clear();
-  frame_info.resize(file->GetFrameCount());
-
-  for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
-  {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
-    AnalyzedFrameInfo& analyzed = frame_info[frame_no];
+  u32 offset = 0;
 
-    u32 offset = 0;
+  u32 part_start = 0;
+  CPState cpmem;
 
-    u32 part_start = 0;
-    CPState cpmem;
+  while (offset < frame.fifoData.size())
+  {
+    const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
+                                                   u32(frame.fifoData.size()) - offset, *this);
 
-    while (offset < frame.fifoData.size())
+    if (m_start_of_primitives)
     {
-      const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
-                                                     u32(frame.fifoData.size()) - offset, analyzer);
-
-      if (analyzer.m_start_of_primitives)
-      {
-        // Start of primitive data for an object
-        analyzed.AddPart(FramePartType::Commands, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-        // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
-        // primitive data, and the first opcode might update cpmem
-        static_assert(std::is_trivially_copyable_v<CPState>);
-        std::memcpy(static_cast<void*>(&cpmem), static_cast<const void*>(&analyzer.m_cpmem),
-                    sizeof(CPState));
-      }
-      if (analyzer.m_end_of_primitives)
-      {
-        // End of primitive data for an object, and thus end of the object
-        analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
-        part_start = offset;
-      }
+      // Start of primitive data for an object
+      analyzed.AddPart(FramePartType::Commands, part_start, offset, m_cpmem);
+      part_start = offset;
+      // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
+      // primitive data, and the first opcode might update cpmem
+      static_assert(std::is_trivially_copyable_v<CPState>);
+      std::memcpy(static_cast<void*>(&cpmem), static_cast<const void*>(&m_cpmem),
+                  sizeof(CPState));
+    }
+    if (m_end_of_primitives)
+    {
+      // End of primitive data for an object, and thus end of the object
+      analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
+      part_start = offset;
+    }
 
-      offset += cmd_size;
+    offset += cmd_size;
 
-      if (analyzer.m_efb_copy)
-      {
-        // We increase the offset beforehand, so that the trigger EFB copy command is included.
-        analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-      }
+    if (m_efb_copy)
+    {
+      // We increase the offset beforehand, so that the trigger EFB copy command is included.
+      analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, m_cpmem);
+      part_start = offset;
     }
-
-    // The frame should end with an EFB copy, so part_start should have been updated to the end.
-    ASSERT(part_start == frame.fifoData.size());
-    ASSERT(offset == frame.fifoData.size());
   }
+
+  // The frame should end with an EFB copy, so part_start should have been updated to the end.
+  ASSERT(part_start == frame.fifoData.size());
+  ASSERT(offset == frame.fifoData.size());
 }
 
 void FifoPlaybackAnalyzer::OnBP(u8 command, u32 value)
@@ -168,7 +157,6 @@ void FifoPlaybackAnalyzer::OnCommand(const u8* data, u32 size)
   m_is_copy = false;
   m_is_nop = false;
 }
-}  // namespace
 
 bool IsPlayingBackFifologWithBrokenEFBCopies = false;
 
@@ -191,7 +179,12 @@ bool FifoPlayer::Open(const std::string& filename)
 
   if (m_File)
   {
-    FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
+    // Frames are only analyzed once they are needed, so that opening long captures is fast.
+    std::lock_guard lk(m_frame_info_lock);
+    m_analyzer = std::make_unique<FifoPlaybackAnalyzer>(m_File->GetCPMem());
+    m_FrameInfo.clear();
+    m_FrameInfo.resize(m_File->GetFrameCount());
+    m_analyzed_frame_count = 0;
 
     m_FrameRangeEnd = m_File->GetFrameCount() - 1;
   }
@@ -204,6 +197,13 @@ bool FifoPlayer::Open(const std::string& filename)
 
 void FifoPlayer::Close()
 {
+  {
+    std::lock_guard lk(m_frame_info_lock);
+    m_analyzer.reset();
+    m_FrameInfo.clear();
+    m_analyzed_frame_count = 0;
+  }
+
   m_File.reset();
 
   m_FrameRangeStart = 0;
@@ -251,7 +251,8 @@ public:
   void Run() override
   {
     auto& cpu = m_parent->m_system.GetCPU();
-    while (cpu.GetState() == CPU::State::Running)
+    const CPU::State* state_ptr = cpu.GetStatePtr();
+    while (*state_ptr == CPU::State::Running)
     {
       switch (m_parent->AdvanceFrame())
       {
@@ -297,7 +298,7 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), GetAnalyzedFrameInfo(m_CurrentFrame));
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -340,10 +341,13 @@ bool FifoPlayer::IsRunningWithFakeVideoInterfaceUpdates() const
 
 u32 FifoPlayer::GetMaxObjectCount() const
 {
+  if (!m_File)
+    return 0;
+
   u32 result = 0;
-  for (auto& frame : m_FrameInfo)
+  for (u32 frame = 0; frame < m_File->GetFrameCount(); ++frame)
   {
-    const u32 count = frame.part_type_counts[FramePartType::PrimitiveData];
+    const u32 count = GetAnalyzedFrameInfo(frame).part_type_counts[FramePartType::PrimitiveData];
     if (count > result)
       result = count;
   }
@@ -352,14 +356,28 @@ u32 FifoPlayer::GetMaxObjectCount() const
 
 u32 FifoPlayer::GetFrameObjectCount(u32 frame) const
 {
-  if (frame < m_FrameInfo.size())
+  if (m_File && frame < m_File->GetFrameCount())
   {
-    return m_FrameInfo[frame].part_type_counts[FramePartType::PrimitiveData];
+    return GetAnalyzedFrameInfo(frame).part_type_counts[FramePartType::PrimitiveData];
   }
 
   return 0;
 }
 
+const AnalyzedFrameInfo& FifoPlayer::GetAnalyzedFrameInfo(u32 frame) const
+{
+  std::lock_guard lk(m_frame_info_lock);
+
+  for (; m_analyzed_frame_count <= frame; ++m_analyzed_frame_count)
+  {
+    const std::shared_ptr<const FifoFrameInfo> frame_info = m_File->GetFrame(m_analyzed_frame_count);
+    m_analyzer->AnalyzeFrame(*frame_info, m_FrameInfo[m_analyzed_frame_count]);
+  }
+
+  // The vector is never resized while a file is open, so the reference stays valid.
+  return m_FrameInfo[frame];
+}
+
 u32 FifoPlayer::GetCurrentFrameObjectCount() const
 {
   return GetFrameObjectCount(m_CurrentFrame);
@@ -480,14 +498,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 {
   ASSERT(m_File);
 
-  for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
-  {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
-    {
-      WriteMemory(update);
-    }
-  }
+  for (const MemoryUpdate& update : m_File->GetFinalMemoryUpdates())
+    WriteMemory(update);
 }
 
 void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
@@ -547,7 +559,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "VideoCommon/OpcodeDecoding.h"
 
 class FifoDataFile;
+class FifoPlaybackAnalyzer;
 struct MemoryUpdate;
 
 namespace Core
@@ -119,7 +121,8 @@ public:
   u32 GetFrameObjectCount(u32 frame) const;
   u32 GetCurrentFrameObjectCount() const;
   u32 GetCurrentFrameNum() const { return m_CurrentFrame; }
-  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame) const { return m_FrameInfo[frame]; }
+  // Analyzes the frames up to the given one if that hasn't happened yet.
+  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame) const;
   // Frame range
   u32 GetFrameRangeStart() const { return m_FrameRangeStart; }
   void SetFrameRangeStart(u32 start);
@@ -204,5 +207,9 @@ private:
 
   std::unique_ptr<FifoDataFile> m_File;
 
-  std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  // Analyzed frames come first in m_FrameInfo, which has an entry for every frame of the file.
+  mutable std::mutex m_frame_info_lock;
+  mutable std::unique_ptr<FifoPlaybackAnalyzer> m_analyzer;
+  mutable std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  mutable u32 m_analyzed_frame_count = 0;
 };
@@ -6,6 +6,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <utility>
 
 #include "AudioCommon/AudioCommon.h"
 #include "Common/CommonTypes.h"
@@ -109,6 +110,10 @@ void CPUManager::Run()
       state_lock.lock();
       m_state_cpu_thread_active = false;
       m_state_cpu_idle_cvar.notify_all();
+
+      // If the run loop was only left for AddRunLoopExitJob, run the jobs and then go back in.
+      if (std::exchange(m_state_run_loop_exit_requested, false))
+        m_state = State::Running;
       break;
 
     case State::Stepping:
@@ -188,6 +193,7 @@ void CPUManager::Stop()
   // will stick permanently.
   std::unique_lock state_lock(m_state_change_lock);
   m_state = State::PowerDown;
+  m_state_run_loop_exit_requested = false;
   m_state_cpu_cvar.notify_one();
 
   while (m_state_cpu_thread_active)
@@ -201,12 +207,13 @@ void CPUManager::Stop()
 
 bool CPUManager::IsStepping() const
 {
-  return m_state == State::Stepping;
+  return m_state == State::Stepping && !m_state_run_loop_exit_requested;
 }
 
 State CPUManager::GetState() const
 {
-  return m_state;
+  // Leaving the run loop for AddRunLoopExitJob isn't a pause.
+  return m_state_run_loop_exit_requested ? State::Running : m_state;
 }
 
 const State* CPUManager::GetStatePtr() const
@@ -244,6 +251,7 @@ bool CPUManager::SetStateLocked(State s)
   if (m_state == State::PowerDown)
     return false;
   m_state = s;
+  m_state_run_loop_exit_requested = false;
   return true;
 }
 
@@ -307,7 +315,7 @@ bool CPUManager::PauseAndLock(bool do_lock, bool unpause_on_unlock, bool control
     std::unique_lock state_lock(m_state_change_lock);
     m_state_paused_and_locked = true;
 
-    was_unpaused = m_state == State::Running;
+    was_unpaused = GetState() == State::Running;
     SetStateLocked(State::Stepping);
 
     while (m_state_cpu_thread_active)
@@ -363,4 +371,18 @@ void CPUManager::AddCPUThreadJob(std::function<void()> function)
   m_pending_jobs.push(std::move(function));
 }
 
+void CPUManager::AddRunLoopExitJob(std::function<void()> function)
+{
+  std::unique_lock state_lock(m_state_change_lock);
+  m_pending_jobs.push(std::move(function));
+
+  // The run loops return at the end of the slice once the state isn't State::Running. If the CPU
+  // Thread isn't in the run loop, the job runs the next time it gets to the top of Run anyway.
+  if (m_state == State::Running)
+  {
+    m_state = State::Stepping;
+    m_state_run_loop_exit_requested = true;
+  }
+}
+
 }  // namespace CPU
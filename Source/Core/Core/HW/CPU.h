@@ -82,6 +82,8 @@ public:
 
   // Direct State Access (Raw pointer for embedding into JIT Blocks)
   // Strictly read-only. A lock is required to change the value.
+  // The run loops have to return as soon as this isn't State::Running. It can differ from
+  // GetState while the CPU Thread is leaving the run loop for AddRunLoopExitJob.
   const State* GetStatePtr() const;
 
   // Locks the CPU Thread (waiting for it to become idle).
@@ -99,6 +101,13 @@ public:
   // PauseAndLock(), as while the CPU is in the run loop, it won't execute the function.
   void AddCPUThreadJob(std::function<void()> function);
 
+  // Adds a job to be executed on the CPU thread, and makes the CPU thread leave the run loop at the
+  // end of the current slice to execute it, after which it continues running. Unlike
+  // AddCPUThreadJob, this doesn't pause emulation or wait for any other thread, so it can be used
+  // from the CPU thread itself, by code that runs in the middle of a block and needs something
+  // like a savestate that can only be done between two blocks.
+  void AddRunLoopExitJob(std::function<void()> function);
+
 private:
   void FlushStepSyncEventLocked();
   void ExecutePendingJobs(std::unique_lock<std::mutex>& state_lock);
@@ -131,6 +140,9 @@ private:
   bool m_state_paused_and_locked = false;
   bool m_state_system_request_stepping = false;
   bool m_state_cpu_step_instruction = false;
+  // Set while m_state is State::Stepping only to make the CPU Thread leave the run loop for
+  // AddRunLoopExitJob. Cleared when the state is changed by anything else.
+  bool m_state_run_loop_exit_requested = false;
   Common::Event* m_state_cpu_step_instruction_sync = nullptr;
   std::queue<std::function<void()>> m_pending_jobs;
 
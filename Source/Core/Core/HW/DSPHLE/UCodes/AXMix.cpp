@@ -0,0 +1,127 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+#include <algorithm>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::AXMix
+{
+s16 MixAddScalar(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta)
+{
+  s16 last_sample = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    last_sample = (s16)sample;
+  }
+  return last_sample;
+}
+
+// The product of an s16 sample and a u16 volume always fits in an s32, and clamping to
+// [-32767, 32767] after the shift is the same as a saturating pack followed by a max with -32767.
+// Both SIMD paths rely on this to process 8 samples at a time with 32-bit lanes.
+
+#if defined(_M_X86_64)
+s16 MixAdd(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta)
+{
+  const u32 vector_count = count & ~7u;
+  if (vector_count == 0)
+    return MixAddScalar(out, input, count, volume, volume_delta);
+
+  const __m128i delta = _mm_set1_epi16(static_cast<s16>(volume_delta));
+  const __m128i delta_x8 = _mm_slli_epi16(delta, 3);
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  __m128i volumes = _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                                  _mm_mullo_epi16(delta, _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+
+  __m128i samples = _mm_setzero_si128();
+  for (u32 i = 0; i < vector_count; i += 8)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+    // Signed * unsigned 16-bit multiply: the signed high half is off by `in` for volumes with the
+    // top bit set.
+    const __m128i lo = _mm_mullo_epi16(in, volumes);
+    const __m128i hi = _mm_add_epi16(_mm_mulhi_epi16(in, volumes),
+                                     _mm_and_si128(in, _mm_srai_epi16(volumes, 15)));
+    const __m128i product_0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+    const __m128i product_1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+    samples = _mm_max_epi16(_mm_packs_epi32(product_0, product_1), min_sample);
+
+    // Sign-extend the samples back to 32 bits and accumulate.
+    __m128i* out_ptr = reinterpret_cast<__m128i*>(out + i);
+    const __m128i samples_0 = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i samples_1 = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_si128(out_ptr, _mm_add_epi32(_mm_loadu_si128(out_ptr), samples_0));
+    _mm_storeu_si128(out_ptr + 1, _mm_add_epi32(_mm_loadu_si128(out_ptr + 1), samples_1));
+
+    volumes = _mm_add_epi16(volumes, delta_x8);
+  }
+
+  volume = static_cast<u16>(_mm_cvtsi128_si32(volumes));
+  const s16 last_sample = static_cast<s16>(_mm_extract_epi16(samples, 7));
+  if (vector_count == count)
+    return last_sample;
+
+  return MixAddScalar(out + vector_count, input + vector_count, count - vector_count, volume,
+                      volume_delta);
+}
+#elif defined(_M_ARM_64)
+s16 MixAdd(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta)
+{
+  const u32 vector_count = count & ~7u;
+  if (vector_count == 0)
+    return MixAddScalar(out, input, count, volume, volume_delta);
+
+  static constexpr u16 LANES[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  const uint16x8_t delta = vdupq_n_u16(volume_delta);
+  const uint16x8_t delta_x8 = vshlq_n_u16(delta, 3);
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+  uint16x8_t volumes = vmlaq_u16(vdupq_n_u16(volume), delta, vld1q_u16(LANES));
+
+  int16x8_t samples = vdupq_n_s16(0);
+  for (u32 i = 0; i < vector_count; i += 8)
+  {
+    const int16x8_t in = vld1q_s16(input + i);
+
+    const int32x4_t volumes_0 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes)));
+    const int32x4_t volumes_1 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes)));
+    const int32x4_t product_0 = vshrq_n_s32(vmulq_s32(vmovl_s16(vget_low_s16(in)), volumes_0), 15);
+    const int32x4_t product_1 = vshrq_n_s32(vmulq_s32(vmovl_s16(vget_high_s16(in)), volumes_1), 15);
+    samples = vmaxq_s16(vcombine_s16(vqmovn_s32(product_0), vqmovn_s32(product_1)), min_sample);
+
+    vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(samples)));
+    vst1q_s32(out + i + 4, vaddw_s16(vld1q_s32(out + i + 4), vget_high_s16(samples)));
+
+    volumes = vaddq_u16(volumes, delta_x8);
+  }
+
+  volume = vgetq_lane_u16(volumes, 0);
+  const s16 last_sample = vgetq_lane_s16(samples, 7);
+  if (vector_count == count)
+    return last_sample;
+
+  return MixAddScalar(out + vector_count, input + vector_count, count - vector_count, volume,
+                      volume_delta);
+}
+#else
+s16 MixAdd(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta)
+{
+  return MixAddScalar(out, input, count, volume, volume_delta);
+}
+#endif
+}  // namespace DSP::HLE::AXMix
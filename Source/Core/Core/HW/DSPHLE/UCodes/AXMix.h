@@ -0,0 +1,20 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Mixing kernels shared by AX GC and AX Wii. AXVoice.h calls these once per mix bus for every
+// running voice, which makes them the hottest loops of AX HLE.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE::AXMix
+{
+// Adds (input * volume) >> 15, clamped to [-32767, 32767], to out. The 16-bit volume is
+// incremented by volume_delta (wrapping around) after every sample and written back.
+// Returns the last mixed sample, or 0 if count is 0.
+s16 MixAdd(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta);
+
+// Reference implementation of MixAdd. The SIMD implementation must match it bit for bit.
+s16 MixAddScalar(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta);
+}  // namespace DSP::HLE::AXMix
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -269,6 +270,8 @@ void GCMemcardDirectory::FlushThread()
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
 
   constexpr std::chrono::seconds flush_interval{1};
+  // Games that keep writing still get their saves flushed this long after the first write.
+  constexpr std::chrono::seconds max_flush_delay{5};
   while (true)
   {
     // no-op until signalled
@@ -277,7 +280,8 @@ void GCMemcardDirectory::FlushThread()
     if (m_exiting.TestAndClear())
       return;
     // no-op as long as signalled within flush_interval
-    while (m_flush_trigger.WaitFor(flush_interval))
+    const auto deadline = std::chrono::steady_clock::now() + max_flush_delay;
+    while (std::chrono::steady_clock::now() < deadline && m_flush_trigger.WaitFor(flush_interval))
     {
       if (m_exiting.TestAndClear())
         return;
@@ -402,7 +406,7 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
       m_last_block_address = (u8*)&m_bat2;
       break;
     default:
-      m_last_block = SaveAreaRW(block, true);
+      m_last_block = SaveAreaRW(block);
       if (m_last_block == -1)
       {
         PanicAlertFmtT("Report: GCIFolder Writing to unallocated block {0:#x}", block);
@@ -411,6 +415,9 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
     }
   }
 
+  // The block may have been looked up by an earlier access that happened before the last flush
+  if (block >= static_cast<s32>(Memcard::MC_FST_BLOCKS))
+    m_saves[m_last_save_index].m_dirty = true;
   memcpy(m_last_block_address + offset, src_address, length);
 
   l.unlock();
@@ -429,6 +436,7 @@ void GCMemcardDirectory::ClearBlock(u32 address)
     return;
   }
 
+  std::lock_guard l(m_write_mutex);
   const u32 block = address / Memcard::BLOCK_SIZE;
   INFO_LOG_FMT(EXPANSIONINTERFACE, "Clearing block {}", block);
   switch (block)
@@ -454,9 +462,10 @@ void GCMemcardDirectory::ClearBlock(u32 address)
     m_last_block_address = (u8*)&m_bat2;
     break;
   default:
-    m_last_block = SaveAreaRW(block, true);
+    m_last_block = SaveAreaRW(block);
     if (m_last_block == -1)
       return;
+    m_saves[m_last_save_index].m_dirty = true;
   }
   std::memset(m_last_block_address, 0xFF, Memcard::BLOCK_SIZE);
 }
@@ -525,7 +534,7 @@ inline void GCMemcardDirectory::SyncSaves()
     }
   }
 }
-inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
+inline s32 GCMemcardDirectory::SaveAreaRW(u32 block)
 {
   for (u16 i = 0; i < m_saves.size(); ++i)
   {
@@ -549,11 +558,7 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
           }
         }
 
-        if (writing)
-        {
-          m_saves[i].m_dirty = true;
-        }
-
+        m_last_save_index = i;
         m_last_block = block;
         m_last_block_address = m_saves[i].m_save_data[idx].m_block.data();
         return m_last_block;
@@ -620,95 +625,146 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
-  std::unique_lock l(m_write_mutex);
-  Memcard::DEntry invalid;
-  for (Memcard::GCIFile& save : m_saves)
+  std::lock_guard flush_lock(m_flush_mutex);
+  const u64 start_us = Common::Timer::NowUs();
+
+  // The contents of changed saves are copied while holding the write lock, and written afterwards,
+  // so that the emulated memory card doesn't have to wait for the host file system.
+  std::vector<PendingGCI> pending_files;
+  std::vector<std::string> deleted_files;
   {
-    if (save.m_dirty)
+    std::unique_lock l(m_write_mutex);
+    Memcard::DEntry invalid;
+    for (Memcard::GCIFile& save : m_saves)
     {
-      if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
+      if (save.m_dirty)
       {
-        save.m_dirty = false;
-        if (save.m_save_data.empty())
-        {
-          // The save's header has been changed but the actual save blocks haven't been read/written
-          // to
-          // skip flushing this file until actual save data is modified
-          ERROR_LOG_FMT(EXPANSIONINTERFACE,
-                        "GCI header modified without corresponding save data changes");
-          continue;
-        }
-        if (save.m_filename.empty())
+        if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
         {
-          std::string default_save_name =
-              m_save_directory + GenerateDefaultGCIFilename(save.m_gci_header, m_hdr.IsShiftJIS());
-
-          // Check to see if another file is using the same name
-          // This seems unlikely except in the case of file corruption
-          // otherwise what user would name another file this way?
-          for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+          save.m_dirty = false;
+          if (save.m_save_data.empty())
           {
-            default_save_name.insert(default_save_name.end() - 4, '0');
+            // The save's header has been changed but the actual save blocks haven't been
+            // read/written to
+            // skip flushing this file until actual save data is modified
+            ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                          "GCI header modified without corresponding save data changes");
+            continue;
           }
-          if (File::Exists(default_save_name))
+          if (save.m_filename.empty())
           {
-            PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
-                           default_save_name);
+            std::string default_save_name =
+                m_save_directory +
+                GenerateDefaultGCIFilename(save.m_gci_header, m_hdr.IsShiftJIS());
+
+            // Check to see if another file is using the same name
+            // This seems unlikely except in the case of file corruption
+            // otherwise what user would name another file this way?
+            for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+            {
+              default_save_name.insert(default_save_name.end() - 4, '0');
+            }
+            if (File::Exists(default_save_name))
+            {
+              PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
+                             default_save_name);
+            }
+            save.m_filename = default_save_name;
           }
-          save.m_filename = default_save_name;
-        }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
-          }
-          else
-          {
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 10000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
+          PendingGCI& file = pending_files.emplace_back();
+          file.filename = save.m_filename;
+          file.contents.resize(Memcard::DENTRY_SIZE +
+                               save.m_save_data.size() * Memcard::BLOCK_SIZE);
+          std::memcpy(file.contents.data(), &save.m_gci_header, Memcard::DENTRY_SIZE);
+          std::memcpy(file.contents.data() + Memcard::DENTRY_SIZE, save.m_save_data.data(),
+                      save.m_save_data.size() * Memcard::BLOCK_SIZE);
         }
-        else
+        else if (save.m_filename.length() != 0)
         {
-          Core::DisplayMessage(
-              fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
-          ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
-                        save.m_filename);
+          save.m_dirty = false;
+          deleted_files.push_back(std::move(save.m_filename));
+          save.m_filename.clear();
+          save.m_save_data.clear();
+          save.m_used_blocks.clear();
         }
       }
-      else if (save.m_filename.length() != 0)
+
+      // Unload the save data for any game that is not running
+      // we could use !m_dirty, but some games have multiple gci files and may not write to them
+      // simultaneously
+      // this ensures that the save data for all of the current games gci files are stored in the
+      // savestate
+      const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
+      if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
       {
-        save.m_dirty = false;
-        std::string& old_name = save.m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
-        save.m_filename.clear();
+        INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
         save.m_save_data.clear();
-        save.m_used_blocks.clear();
       }
     }
+  }
+
+  for (const std::string& old_name : deleted_files)
+  {
+    std::string deleted_name = old_name + ".deleted";
+    if (File::Exists(deleted_name))
+      File::Delete(deleted_name);
+    File::Rename(old_name, deleted_name);
+    m_flushed_hashes.erase(old_name);
+  }
+
+  u64 bytes_written = 0;
+  size_t files_written = 0;
+  for (const PendingGCI& file : pending_files)
+  {
+    // Games tend to rewrite saves without changing them, and a save is often changed several
+    // times between flushes. Only the latest contents are written, and only if they changed.
+    const XXH128_hash_t hash = XXH3_128bits(file.contents.data(), file.contents.size());
+    const auto flushed = m_flushed_hashes.find(file.filename);
+    if (flushed != m_flushed_hashes.end() && flushed->second.first == hash.low64 &&
+        flushed->second.second == hash.high64)
+    {
+      continue;
+    }
+
+    // Write a temporary file first, so that the GCI is never left partially written
+    const std::string temp_path = File::GetTempFilenameForAtomicWrite(file.filename);
+    bool success;
+    {
+      // This temporary file must be closed before it can be renamed.
+      File::IOFile gci(temp_path, "wb");
+      success = gci.WriteBytes(file.contents.data(), file.contents.size());
+    }
+    success = success && File::Rename(temp_path, file.filename);
 
-    // Unload the save data for any game that is not running
-    // we could use !m_dirty, but some games have multiple gci files and may not write to them
-    // simultaneously
-    // this ensures that the save data for all of the current games gci files are stored in the
-    // savestate
-    const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
-    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
+    if (!success)
     {
-      INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
-      save.m_save_data.clear();
+      File::Delete(temp_path, File::IfAbsentBehavior::NoConsoleWarning);
+      m_flushed_hashes.erase(file.filename);
+      Core::DisplayMessage(fmt::format("Failed to write save contents to {}", file.filename),
+                           10000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", file.filename);
+      continue;
     }
+
+    m_flushed_hashes[file.filename] = {hash.low64, hash.high64};
+    bytes_written += file.contents.size();
+    ++files_written;
   }
+
+  if (files_written != 0)
+    Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
+
+  if (!pending_files.empty() || !deleted_files.empty())
+  {
+    m_total_bytes_flushed += bytes_written;
+    INFO_LOG_FMT(EXPANSIONINTERFACE,
+                 "Flushed {} of {} changed GCI files ({} bytes, {} deleted) in {} us, {} bytes "
+                 "written since the card was inserted",
+                 files_written, pending_files.size(), bytes_written, deleted_files.size(),
+                 Common::Timer::NowUs() - start_us, m_total_bytes_flushed);
+  }
+
 #if _WRITE_MC_HEADER
   u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
   Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
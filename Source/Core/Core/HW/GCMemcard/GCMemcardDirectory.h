@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "Common/Event.h"
@@ -42,8 +44,14 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  struct PendingGCI
+  {
+    std::string filename;
+    std::vector<u8> contents;
+  };
+
   bool LoadGCI(Memcard::GCIFile gci);
-  inline s32 SaveAreaRW(u32 block, bool writing = false);
+  inline s32 SaveAreaRW(u32 block);
   // s32 DirectoryRead(u32 offset, u32 length, u8* dest_address);
   s32 DirectoryWrite(u32 dest_address, u32 length, const u8* src_address);
   inline void SyncSaves();
@@ -52,6 +60,8 @@ private:
   u32 m_game_id;
   s32 m_last_block;
   u8* m_last_block_address;
+  // The save that m_last_block belongs to, if it is in the save area
+  int m_last_save_index = -1;
 
   Memcard::Header m_hdr;
   Memcard::Directory m_dir1;
@@ -63,6 +73,11 @@ private:
   std::string m_save_directory;
   Common::Event m_flush_trigger;
   std::mutex m_write_mutex;
+  // Held while flushing, which partly happens without m_write_mutex
+  std::mutex m_flush_mutex;
+  // Hashes of the contents last written to each GCI file, to skip writing them again unchanged
+  std::map<std::string, std::pair<u64, u64>> m_flushed_hashes;
+  u64 m_total_bytes_flushed = 0;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
 };
@@ -124,6 +124,9 @@ void MemoryManager::Init()
   m_arena.GrabSHMSegment(mem_size, "dolphin-emu");
 
   m_physical_page_mappings.fill(nullptr);
+  m_logical_page_mappings.fill(nullptr);
+  m_logical_page_translations.fill(0);
+  m_logical_memory_stats = {};
 
   // Create an anonymous view of the physical memory
   for (const PhysicalMemoryRegion& region : m_physical_regions)
@@ -230,64 +233,101 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+
+  // Map the DBAT translations that were set up while there was no arena.
+  for (u32 i = 0; i < m_logical_page_translations.size(); ++i)
+  {
+    if (m_logical_page_translations[i] != 0)
+      MapLogicalPage(i);
+  }
+
   return true;
 }
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
-  for (auto& entry : m_logical_mapped_entries)
+  ++m_logical_memory_stats.updates;
+
+  for (u32 i = 0; i < dbat_table.size(); ++i)
   {
-    m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
+    u32 translation = 0;
+    if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
+      translation = dbat_table[i] & (PowerPC::BAT_RESULT_MASK | PowerPC::BAT_PHYSICAL_BIT);
+
+    if (translation == m_logical_page_translations[i])
+      continue;
+
+    if (m_logical_page_translations[i] != 0)
+    {
+      UnmapLogicalPage(i);
+      ++m_logical_memory_stats.pages_unmapped;
+    }
+
+    m_logical_page_translations[i] = translation;
+
+    if (translation != 0)
+    {
+      MapLogicalPage(i);
+      ++m_logical_memory_stats.pages_mapped;
+    }
   }
-  m_logical_mapped_entries.clear();
+}
 
-  m_logical_page_mappings.fill(nullptr);
+void MemoryManager::MapLogicalPage(u32 page)
+{
+  const u32 logical_address = page << PowerPC::BAT_INDEX_SHIFT;
+  const u32 logical_size = PowerPC::BAT_PAGE_SIZE;
+  const u32 translated_address = m_logical_page_translations[page] & PowerPC::BAT_RESULT_MASK;
 
-  for (u32 i = 0; i < dbat_table.size(); ++i)
+  // The physical regions are aligned to BAT pages, so a page overlaps at most one of them.
+  for (const auto& physical_region : m_physical_regions)
   {
-    if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
+    if (!physical_region.active)
+      continue;
+
+    u32 mapping_address = physical_region.physical_address;
+    u32 mapping_end = mapping_address + physical_region.size;
+    u32 intersection_start = std::max(mapping_address, translated_address);
+    u32 intersection_end = std::min(mapping_end, translated_address + logical_size);
+    if (intersection_start >= intersection_end)
+      continue;
+
+    // Found an overlapping region; map it.
+
+    LogicalMemoryView& entry = m_logical_mapped_entries[page];
+    if (m_is_fastmem_arena_initialized && !entry.mapped_pointer)
     {
-      u32 logical_address = i << PowerPC::BAT_INDEX_SHIFT;
-      // TODO: Merge adjacent mappings to make this faster.
-      u32 logical_size = PowerPC::BAT_PAGE_SIZE;
-      u32 translated_address = dbat_table[i] & PowerPC::BAT_RESULT_MASK;
-      for (const auto& physical_region : m_physical_regions)
+      u32 position = physical_region.shm_position + intersection_start - mapping_address;
+      u8* base = m_logical_base + logical_address + intersection_start - translated_address;
+      u32 mapped_size = intersection_end - intersection_start;
+
+      void* mapped_pointer = m_arena.MapInMemoryRegion(position, mapped_size, base);
+      if (!mapped_pointer)
       {
-        if (!physical_region.active)
-          continue;
-
-        u32 mapping_address = physical_region.physical_address;
-        u32 mapping_end = mapping_address + physical_region.size;
-        u32 intersection_start = std::max(mapping_address, translated_address);
-        u32 intersection_end = std::min(mapping_end, translated_address + logical_size);
-        if (intersection_start < intersection_end)
-        {
-          // Found an overlapping region; map it.
-
-          if (m_is_fastmem_arena_initialized)
-          {
-            u32 position = physical_region.shm_position + intersection_start - mapping_address;
-            u8* base = m_logical_base + logical_address + intersection_start - translated_address;
-            u32 mapped_size = intersection_end - intersection_start;
-
-            void* mapped_pointer = m_arena.MapInMemoryRegion(position, mapped_size, base);
-            if (!mapped_pointer)
-            {
-              PanicAlertFmt(
-                  "Memory::UpdateLogicalMemory(): Failed to map memory region at 0x{:08X} "
-                  "(size 0x{:08X}) into logical fastmem region at 0x{:08X}.",
-                  intersection_start, mapped_size, logical_address);
-              exit(0);
-            }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
-          }
-
-          m_logical_page_mappings[i] =
-              *physical_region.out_pointer + intersection_start - mapping_address;
-        }
+        PanicAlertFmt("Memory::UpdateLogicalMemory(): Failed to map memory region at 0x{:08X} "
+                      "(size 0x{:08X}) into logical fastmem region at 0x{:08X}.",
+                      intersection_start, mapped_size, logical_address);
+        exit(0);
       }
+      entry = {mapped_pointer, mapped_size};
     }
+
+    m_logical_page_mappings[page] =
+        *physical_region.out_pointer + intersection_start - mapping_address;
+    break;
+  }
+}
+
+void MemoryManager::UnmapLogicalPage(u32 page)
+{
+  LogicalMemoryView& entry = m_logical_mapped_entries[page];
+  if (entry.mapped_pointer)
+  {
+    m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
+    entry = {};
   }
+
+  m_logical_page_mappings[page] = nullptr;
 }
 
 void MemoryManager::DoState(PointerWrap& p)
@@ -373,9 +413,11 @@ void MemoryManager::ShutdownFastmemArena()
 
   for (auto& entry : m_logical_mapped_entries)
   {
+    if (!entry.mapped_pointer)
+      continue;
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
+    entry = {};
   }
-  m_logical_mapped_entries.clear();
 
   m_arena.ReleaseMemoryRegion();
 
@@ -490,11 +532,23 @@ std::string MemoryManager::GetString(u32 em_address, size_t size)
 }
 
 std::span<u8> MemoryManager::GetSpanForAddress(u32 address) const
+{
+  const std::span<u8> span = TryGetSpanForAddress(address);
+  if (span.data() == nullptr)
+  {
+    auto& ppc_state = m_system.GetPPCState();
+    PanicAlertFmt("Unknown Pointer {:#010x} PC {:#010x} LR {:#010x}", address & 0x3FFFFFFF,
+                  ppc_state.pc, LR(ppc_state));
+  }
+  return span;
+}
+
+std::span<u8> MemoryManager::TryGetSpanForAddress(u32 address) const
 {
   // TODO: Should we be masking off more bits here?  Can all devices access
   // EXRAM?
   address &= 0x3FFFFFFF;
-  if (address < GetRamSizeReal())
+  if (m_ram && address < GetRamSizeReal())
     return std::span(m_ram + address, GetRamSizeReal() - address);
 
   if (m_exram)
@@ -506,9 +560,6 @@ std::span<u8> MemoryManager::GetSpanForAddress(u32 address) const
     }
   }
 
-  auto& ppc_state = m_system.GetPPCState();
-  PanicAlertFmt("Unknown Pointer {:#010x} PC {:#010x} LR {:#010x}", address, ppc_state.pc,
-                LR(ppc_state));
   return {};
 }
 
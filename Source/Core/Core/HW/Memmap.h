@@ -52,8 +52,16 @@ struct PhysicalMemoryRegion
 
 struct LogicalMemoryView
 {
-  void* mapped_pointer;
-  u32 mapped_size;
+  void* mapped_pointer = nullptr;
+  u32 mapped_size = 0;
+};
+
+struct LogicalMemoryStats
+{
+  // Calls to UpdateLogicalMemory, and the BAT pages they mapped or unmapped.
+  u64 updates = 0;
+  u64 pages_mapped = 0;
+  u64 pages_unmapped = 0;
 };
 
 class MemoryManager
@@ -99,7 +107,10 @@ public:
   void ShutdownFastmemArena();
   void DoState(PointerWrap& p);
 
+  // Only remaps the BAT pages whose translation changed since the previous call. Only DBAT
+  // translations are mapped; accesses translated by the page table always take the slow path.
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
+  const LogicalMemoryStats& GetLogicalMemoryStats() const { return m_logical_memory_stats; }
 
   void Clear();
 
@@ -112,6 +123,10 @@ public:
   // Otherwise, returns a 0-length span starting at nullptr.
   std::span<u8> GetSpanForAddress(u32 address) const;
 
+  // Like GetSpanForAddress, but doesn't raise a panic alert for addresses outside of MEM1 and
+  // MEM2, for callers that have another way of accessing them.
+  std::span<u8> TryGetSpanForAddress(u32 address) const;
+
   // If the specified range is within a single valid memory region, returns a pointer to the start
   // of the corresponding range in host memory. Otherwise, returns nullptr.
   u8* GetPointerForRange(u32 address, size_t size) const;
@@ -247,7 +262,12 @@ private:
   // TODO: Do we want to handle the mirrors of the GC RAM?
   std::array<PhysicalMemoryRegion, 4> m_physical_regions{};
 
-  std::vector<LogicalMemoryView> m_logical_mapped_entries;
+  // For each BAT page, the physical address and BAT_PHYSICAL_BIT of the current DBAT
+  // translation, or 0 if it isn't translated to physical memory.
+  std::array<u32, PowerPC::BAT_PAGE_COUNT> m_logical_page_translations{};
+  // The views mapped into the logical fastmem region for each BAT page.
+  std::array<LogicalMemoryView, PowerPC::BAT_PAGE_COUNT> m_logical_mapped_entries{};
+  LogicalMemoryStats m_logical_memory_stats;
 
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
@@ -255,5 +275,7 @@ private:
   Core::System& m_system;
 
   void InitMMIO(bool is_wii);
+  void MapLogicalPage(u32 page);
+  void UnmapLogicalPage(u32 page);
 };
 }  // namespace Memory
@@ -144,6 +144,61 @@ bool HostFileSystem::FstEntry::CheckPermission(Uid caller_uid, Gid caller_gid,
   return (u8(requested_mode) & u8(file_mode)) == u8(requested_mode);
 }
 
+HostFileSystem::HostEntryInfo HostFileSystem::GetHostEntryInfo(const std::string& host_path)
+{
+  const auto [it, inserted] = m_host_entry_cache.try_emplace(host_path);
+  if (inserted)
+  {
+    const File::FileInfo info{host_path};
+    it->second.exists = info.Exists();
+    it->second.is_directory = info.IsDirectory();
+    it->second.size = info.GetSize();
+  }
+  return it->second;
+}
+
+const std::vector<std::string>&
+HostFileSystem::GetHostDirectoryListing(const std::string& host_path, bool is_root)
+{
+  const auto [it, inserted] = m_host_directory_cache.try_emplace(host_path);
+  if (inserted)
+  {
+    File::FSTEntry host_entry = File::ScanDirectoryTree(host_path, false);
+    FixupDirectoryEntries(&host_entry, is_root);
+    it->second.reserve(host_entry.children.size());
+    for (File::FSTEntry& child : host_entry.children)
+      it->second.push_back(std::move(child.virtualName));
+  }
+  return it->second;
+}
+
+void HostFileSystem::InvalidateHostCache(const std::string& host_path)
+{
+  const auto erase_path_and_children = [&host_path](auto* cache) {
+    cache->erase(host_path);
+    const std::string prefix = host_path + '/';
+    auto it = cache->lower_bound(prefix);
+    while (it != cache->end() && it->first.starts_with(prefix))
+      it = cache->erase(it);
+  };
+  erase_path_and_children(&m_host_entry_cache);
+  erase_path_and_children(&m_host_directory_cache);
+
+  // The host path of the root directory ends with a slash, unlike the other ones.
+  const std::string parent = host_path.substr(0, host_path.rfind('/'));
+  m_host_directory_cache.erase(parent);
+  m_host_directory_cache.erase(parent + '/');
+
+  m_directory_stats_cache.clear();
+}
+
+void HostFileSystem::ClearHostCache()
+{
+  m_host_entry_cache.clear();
+  m_host_directory_cache.clear();
+  m_directory_stats_cache.clear();
+}
+
 HostFileSystem::HostFileSystem(const std::string& root_path,
                                std::vector<NandRedirect> nand_redirects)
     : m_root_path{root_path}, m_nand_redirects(std::move(nand_redirects))
@@ -245,8 +300,8 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     return nullptr;
 
   auto host_file = BuildFilename(path);
-  const File::FileInfo host_file_info{host_file.host_path};
-  if (!host_file_info.Exists())
+  const HostEntryInfo host_file_info = GetHostEntryInfo(host_file.host_path);
+  if (!host_file_info.exists)
     return nullptr;
 
   FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
@@ -273,7 +328,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     }
   }
 
-  entry->data.is_file = host_file_info.IsFile();
+  entry->data.is_file = !host_file_info.is_directory;
   if (entry->data.is_file && !entry->children.empty())
   {
     WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
@@ -376,6 +431,7 @@ void HostFileSystem::DoState(PointerWrap& p)
   // Temporarily close the file, to prevent any issues with the savestating of files/folders.
   for (Handle& handle : m_handles)
     handle.host_file.reset();
+  ReleaseRecentlyClosedFiles();
 
   // The format for the next part of the save state is follows:
   // 1. bool Movie::WasMovieActiveWhenStateSaved() &&
@@ -431,6 +487,9 @@ void HostFileSystem::DoState(PointerWrap& p)
     }
   }
 
+  if (p.IsReadMode())
+    ClearHostCache();
+
   for (Handle& handle : m_handles)
   {
     p.Do(handle.opened);
@@ -449,7 +508,10 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/").host_path;
-  if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
+  ReleaseRecentlyClosedFiles();
+  const bool ok = File::DeleteDirRecursively(root) && File::CreateDir(root);
+  ClearHostCache();
+  if (!ok)
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
@@ -480,10 +542,11 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   if (!parent->CheckPermission(uid, gid, Mode::Write))
     return ResultCode::AccessDenied;
 
-  if (File::Exists(host_path))
+  if (GetHostEntryInfo(host_path).exists)
     return ResultCode::AlreadyExists;
 
   const bool ok = is_file ? File::CreateEmptyFile(host_path) : File::CreateDir(host_path);
+  InvalidateHostCache(host_path);
   if (!ok)
   {
     ERROR_LOG_FMT(IOS_FS, "Failed to create file or directory: {}", host_path);
@@ -543,15 +606,18 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!parent->CheckPermission(uid, gid, Mode::Write))
     return ResultCode::AccessDenied;
 
-  if (!File::Exists(host_path))
+  const HostEntryInfo host_info = GetHostEntryInfo(host_path);
+  if (!host_info.exists)
     return ResultCode::NotFound;
 
-  if (File::IsFile(host_path) && !IsFileOpened(path))
+  ReleaseRecentlyClosedFiles();
+  if (!host_info.is_directory && !IsFileOpened(path))
     File::Delete(host_path);
-  else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
+  else if (host_info.is_directory && !IsDirectoryInUse(path))
     File::DeleteDirRecursively(host_path);
   else
     return ResultCode::InUse;
+  InvalidateHostCache(host_path);
 
   const auto it = std::find_if(parent->children.begin(), parent->children.end(),
                                GetNamePredicate(split_path.file_name));
@@ -601,11 +667,14 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_old_path = host_old_info.host_path;
   const std::string& host_new_path = host_new_info.host_path;
 
+  ReleaseRecentlyClosedFiles();
+
   // If there is already something of the same type at the new path, delete it.
-  if (File::Exists(host_new_path))
+  const HostEntryInfo host_new_entry = GetHostEntryInfo(host_new_path);
+  if (host_new_entry.exists)
   {
-    const bool old_is_file = File::IsFile(host_old_path);
-    const bool new_is_file = File::IsFile(host_new_path);
+    const bool old_is_file = !GetHostEntryInfo(host_old_path).is_directory;
+    const bool new_is_file = !host_new_entry.is_directory;
     if (old_is_file && new_is_file)
       File::Delete(host_new_path);
     else if (!old_is_file && !new_is_file)
@@ -614,19 +683,26 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
       return ResultCode::Invalid;
   }
 
-  if (!File::Rename(host_old_path, host_new_path))
+  const bool renamed = File::Rename(host_old_path, host_new_path);
+  InvalidateHostCache(host_old_path);
+  InvalidateHostCache(host_new_path);
+  if (!renamed)
   {
     if (host_old_info.is_redirect || host_new_info.is_redirect)
     {
       // If either path is a redirect, the source and target may be on a different partition or
       // device, so a simple rename may not work. Fall back to Copy & Delete and see if that works.
-      if (!File::CopyRegularFile(host_old_path, host_new_path))
+      const bool copied = File::CopyRegularFile(host_old_path, host_new_path);
+      InvalidateHostCache(host_new_path);
+      if (!copied)
       {
         ERROR_LOG_FMT(IOS_FS, "Copying {} to {} in Rename fallback failed", host_old_path,
                       host_new_path);
         return ResultCode::NotFound;
       }
-      if (!File::Delete(host_old_path))
+      const bool deleted = File::Delete(host_old_path);
+      InvalidateHostCache(host_old_path);
+      if (!deleted)
       {
         ERROR_LOG_FMT(IOS_FS, "Deleting {} in Rename fallback failed", host_old_path);
         return ResultCode::Invalid;
@@ -675,8 +751,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
     return ResultCode::Invalid;
 
   const std::string host_path = BuildFilename(path).host_path;
-  File::FSTEntry host_entry = File::ScanDirectoryTree(host_path, false);
-  FixupDirectoryEntries(&host_entry, path == "/");
+  std::vector<std::string> output = GetHostDirectoryListing(host_path, path == "/");
 
   // Sort files according to their order in the FST tree (issue 10234).
   // The result should look like this:
@@ -694,21 +769,18 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
 
   // Now sort in reverse order because Nintendo traverses a linked list
   // in which new elements are inserted at the front.
-  std::sort(host_entry.children.begin(), host_entry.children.end(),
-            [&get_key](const File::FSTEntry& one, const File::FSTEntry& two) {
-              const int key1 = get_key(one.virtualName);
-              const int key2 = get_key(two.virtualName);
+  std::sort(output.begin(), output.end(),
+            [&get_key](const std::string& one, const std::string& two) {
+              const int key1 = get_key(one);
+              const int key2 = get_key(two);
               if (key1 != key2)
                 return key1 > key2;
 
               // For files that are not in the FST, sort lexicographically to ensure that
               // results are consistent no matter what the underlying filesystem is.
-              return one.virtualName > two.virtualName;
+              return one > two;
             });
 
-  std::vector<std::string> output;
-  for (const File::FSTEntry& child : host_entry.children)
-    output.emplace_back(child.virtualName);
   return output;
 }
 
@@ -737,7 +809,8 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  const HostEntryInfo host_info = GetHostEntryInfo(BuildFilename(path).host_path);
+  metadata.size = host_info.is_directory ? 0 : host_info.size;
   return metadata;
 }
 
@@ -756,7 +829,8 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const HostEntryInfo host_info = GetHostEntryInfo(BuildFilename(path).host_path);
+  const bool is_empty = host_info.is_directory || host_info.size == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -824,12 +898,15 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
 
   ExtendedDirectoryStats stats{};
   std::string path(BuildFilename(wii_path).host_path);
-  File::FileInfo info(path);
-  if (!info.Exists())
+  if (const auto it = m_directory_stats_cache.find(path); it != m_directory_stats_cache.end())
+    return it->second;
+
+  const HostEntryInfo info = GetHostEntryInfo(path);
+  if (!info.exists)
   {
     return ResultCode::NotFound;
   }
-  if (info.IsDirectory())
+  if (info.is_directory)
   {
     File::FSTEntry parent_dir = File::ScanDirectoryTree(path, true);
     FixupDirectoryEntries(&parent_dir, wii_path == "/");
@@ -842,11 +919,13 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   {
     return ResultCode::Invalid;
   }
+  m_directory_stats_cache.emplace(std::move(path), stats);
   return stats;
 }
 
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
   m_nand_redirects = std::move(nand_redirects);
+  ClearHostCache();
 }
 }  // namespace IOS::HLE::FS
@@ -4,8 +4,10 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -76,12 +78,27 @@ private:
     std::vector<FstEntry> children;
   };
 
+  /// A host file, shared by all handles that have the same file opened.
+  ///
+  /// Since all accesses to the file go through here, its size and position are tracked to avoid
+  /// the host calls that would query them.
+  struct HostFile
+  {
+    std::string host_path;
+    File::IOFile file;
+    u64 size = 0;
+    /// The position of the host file, if known.
+    std::optional<u64> position;
+    /// Switching between reading and writing needs a seek even if the position matches.
+    bool last_access_was_write = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -94,7 +111,25 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  void SeekHostFile(HostFile* host_file, u64 position, bool write);
+  /// Closes the host files that are only kept open for reuse, so that they can be deleted or
+  /// renamed.
+  void ReleaseRecentlyClosedFiles();
+
+  struct HostEntryInfo
+  {
+    bool exists = false;
+    bool is_directory = false;
+    u64 size = 0;
+  };
+  HostEntryInfo GetHostEntryInfo(const std::string& host_path);
+  const std::vector<std::string>& GetHostDirectoryListing(const std::string& host_path,
+                                                          bool is_root);
+  /// Must be called after the file or directory at the host path has been created, deleted or
+  /// renamed.
+  void InvalidateHostCache(const std::string& host_path);
+  void ClearHostCache();
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -120,9 +155,18 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
+  /// Files whose handles have all been closed are kept open for a while, since games tend to
+  /// open the same files over and over.
+  std::deque<std::shared_ptr<HostFile>> m_recently_closed_files;
   std::array<Handle, 16> m_handles{};
 
+  /// Caches of what is on the host file system, to save host calls when the same paths are looked
+  /// up repeatedly. Kept coherent by the operations that modify the host file system.
+  std::map<std::string, HostEntryInfo> m_host_entry_cache;
+  std::map<std::string, std::vector<std::string>> m_host_directory_cache;
+  std::map<std::string, ExtendedDirectoryStats> m_directory_stats_cache;
+
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
 };
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -13,8 +14,10 @@
 
 namespace IOS::HLE::FS
 {
+constexpr size_t MAX_RECENTLY_CLOSED_FILES = 8;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -60,20 +63,41 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   }
 
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<HostFile> file_ptr(new HostFile{host_path, std::move(file)}, deleter);
+  file_ptr->size = file_ptr->file.GetSize();
+  file_ptr->position = 0;
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+void HostFileSystem::SeekHostFile(HostFile* host_file, u64 position, bool write)
+{
+  // The file might be opened twice, in which case each handle has its own offset, but a series of
+  // accesses through the same handle doesn't need any seeks.
+  if (host_file->position == position && host_file->last_access_was_write == write)
+    return;
+
+  if (host_file->file.Seek(position, File::SeekOrigin::Begin))
+    host_file->position = position;
+  else
+    host_file->position.reset();
+  host_file->last_access_was_write = write;
+}
+
+void HostFileSystem::ReleaseRecentlyClosedFiles()
+{
+  m_recently_closed_files.clear();
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -81,7 +105,8 @@ Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, M
     return ResultCode::NoFreeHandle;
 
   const std::string host_path = BuildFilename(path).host_path;
-  if (!File::IsFile(host_path))
+  const HostEntryInfo host_info = GetHostEntryInfo(host_path);
+  if (!host_info.exists || host_info.is_directory)
   {
     *handle = Handle{};
     return ResultCode::NotFound;
@@ -106,8 +131,13 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
-  // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  // Keep the file open for a while in case it gets opened again. It will automatically close once
+  // it's dropped from the recently closed files and no handle is accessing it.
+  std::erase(m_recently_closed_files, handle->host_file);
+  m_recently_closed_files.push_front(std::move(handle->host_file));
+  if (m_recently_closed_files.size() > MAX_RECENTLY_CLOSED_FILES)
+    m_recently_closed_files.pop_back();
+
   *handle = Handle{};
   return ResultCode::Success;
 }
@@ -115,23 +145,29 @@ ResultCode HostFileSystem::Close(Fd fd)
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  HostFile* host_file = handle->host_file.get();
+  const u32 file_size = static_cast<u32>(host_file->size);
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  SeekHostFile(host_file, handle->file_offset, false);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, host_file->file.GetHandle()));
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(host_file->file.GetHandle()))
+  {
+    host_file->position.reset();
     return ResultCode::AccessDenied;
+  }
+
+  if (host_file->position)
+    *host_file->position += actually_read;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
@@ -142,25 +178,39 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  HostFile* host_file = handle->host_file.get();
+  SeekHostFile(host_file, handle->file_offset, true);
+  if (!host_file->file.WriteBytes(ptr, count))
+  {
+    host_file->position.reset();
     return ResultCode::AccessDenied;
+  }
+
+  if (host_file->position)
+    *host_file->position += count;
 
   handle->file_offset += count;
+  if (handle->file_offset > host_file->size)
+  {
+    host_file->size = handle->file_offset;
+    const auto it = m_host_entry_cache.find(host_file->host_path);
+    if (it != m_host_entry_cache.end())
+      it->second.size = host_file->size;
+    m_directory_stats_cache.clear();
+  }
   return count;
 }
 
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -173,14 +223,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -190,11 +240,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
@@ -10,10 +10,12 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -41,6 +43,7 @@
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/CPU.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #ifdef HAS_LIBMGBA
@@ -65,6 +68,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -926,6 +930,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.sync_codes;
 
     packet >> m_net_settings.golf_mode;
+    packet >> m_net_settings.rollback;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
 
@@ -1761,6 +1766,28 @@ bool NetPlayClient::StartGame(const std::string& path)
 
   m_first_pad_status_received.fill(false);
 
+  // Rollback only covers GameCube controllers, and a movie would record the inputs of the frames
+  // that get simulated again, so fall back to the pad buffers otherwise.
+  m_rollback_active =
+      m_net_settings.rollback && !m_host_input_authority && !m_dialog->IsRecording() &&
+      std::ranges::none_of(m_wiimote_map, [](auto mapping) { return mapping > 0; }) &&
+      std::ranges::none_of(m_gba_config, [](const auto& config) { return config.enabled; });
+  if (m_rollback_active)
+  {
+    std::array<RollbackInputs::PadSource, 4> sources;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      if (m_pad_map[i] == m_local_player->pid)
+        sources[i] = RollbackInputs::PadSource::Local;
+      else if (m_pad_map[i] > 0)
+        sources[i] = RollbackInputs::PadSource::Remote;
+      else
+        sources[i] = RollbackInputs::PadSource::None;
+    }
+    m_rollback.Reset(sources);
+    m_rollback_job_queued = false;
+  }
+
   if (m_dialog->IsRecording())
   {
     auto& movie = Core::System::GetInstance().GetMovie();
@@ -2040,6 +2067,9 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback_active)
+    return GetRollbackPads(pad_nb, pad_status);
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -2173,25 +2203,137 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
   return true;
 }
 
-bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
+// called from ---CPU--- thread
+// In rollback mode, every frame starts when the first in-game pad is polled. The local inputs are
+// sent right away, and the inputs of remote pads are predicted until they arrive.
+bool NetPlayClient::StartRollbackFrame()
 {
-  const int ingame_pad = LocalPadToInGamePad(local_pad);
-  bool data_added = false;
-  GCPadStatus pad_status;
-
-  if (m_gba_config[ingame_pad].enabled)
+  RollbackInputs& inputs = m_rollback.GetInputs();
+  if (inputs.NeedsLocalInputs())
   {
-    pad_status = Pad::GetGBAStatus(local_pad);
+    sf::Packet packet;
+    packet << MessageID::PadData;
+
+    const int num_local_pads = NumLocalPads();
+    for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+    {
+      const int ingame_pad = LocalPadToInGamePad(local_pad);
+      const GCPadStatus pad_status = GetLocalPadStatus(local_pad);
+      inputs.AddLocalInput(ingame_pad, pad_status);
+      AddPadStateToPacket(ingame_pad, pad_status, packet);
+    }
+
+    SendAsync(std::move(packet));
   }
-  else if (Config::Get(Config::GetInfoForSIDevice(local_pad)) ==
-           SerialInterface::SIDEVICE_WIIU_ADAPTER)
+
+  const auto add_remote_inputs = [this, &inputs] {
+    for (int i = 0; i < 4; ++i)
+    {
+      GCPadStatus pad_status;
+      while (m_pad_buffer[i].Pop(pad_status))
+        inputs.AddRemoteInput(i, pad_status);
+    }
+  };
+
+  // This only waits for remote inputs, never for a state to be saved, since that can only happen
+  // after the poll returns.
+  const bool was_resimulating = inputs.IsResimulating();
+  add_remote_inputs();
+  while (m_rollback.Poll() == RollbackController::PollResult::Wait)
   {
-    pad_status = GCAdapter::Input(local_pad);
+    if (!m_is_running.IsSet())
+    {
+      return false;
+    }
+
+    m_gc_pad_event.Wait();
+    add_remote_inputs();
   }
-  else
+
+  if (was_resimulating && !inputs.IsResimulating())
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 1.0f);
+
+  if (m_rollback.HasStateRequest())
+    QueueRollbackJob();
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::QueueRollbackJob()
+{
+  if (std::exchange(m_rollback_job_queued, true))
+    return;
+
+  // The CPU thread leaves the run loop at the end of the slice to run the job, without waiting for
+  // any other thread.
+  auto& system = Core::System::GetInstance();
+  system.GetCPU().AddRunLoopExitJob([&system] {
+    std::lock_guard lk(crit_netplay_client);
+    if (netplay_client)
+      netplay_client->RunRollbackJob(system);
+  });
+}
+
+// called from ---CPU--- thread, outside of the run loop
+// Rolls back to the first mispredicted frame if there is one, and otherwise saves the state at the
+// start of the next frame.
+void NetPlayClient::RunRollbackJob(Core::System& system)
+{
+  m_rollback_job_queued = false;
+  if (!m_rollback_active || !m_is_running.IsSet())
+    return;
+
+  const RollbackController::StateRequest request = m_rollback.TakeStateRequest();
+  std::vector<u8>& buffer = m_rollback_states[RollbackController::GetStateSlot(request.frame)];
+  switch (request.type)
   {
-    pad_status = Pad::GetStatus(local_pad);
+  case RollbackController::StateRequest::Type::None:
+    break;
+
+  case RollbackController::StateRequest::Type::Save:
+    State::SaveToBuffer(system, buffer);
+    m_rollback.StateSaved(request.frame, !buffer.empty());
+    break;
+
+  case RollbackController::StateRequest::Type::Load:
+    INFO_LOG_FMT(NETPLAY, "Rolling back from frame {} to frame {}",
+                 m_rollback.GetInputs().GetPresentFrame(), request.frame);
+    State::LoadFromBufferForRollback(system, buffer);
+
+    // Catch up to the present frame as fast as possible
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    break;
   }
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPads(const int pad_nb, GCPadStatus* pad_status)
+{
+  if (IsFirstInGamePad(pad_nb) && !StartRollbackFrame())
+    return false;
+
+  *pad_status = m_rollback.GetFrameInputs()[pad_nb];
+  return true;
+}
+
+GCPadStatus NetPlayClient::GetLocalPadStatus(const int local_pad) const
+{
+  const int ingame_pad = LocalPadToInGamePad(local_pad);
+
+  if (m_gba_config[ingame_pad].enabled)
+    return Pad::GetGBAStatus(local_pad);
+
+  if (Config::Get(Config::GetInfoForSIDevice(local_pad)) == SerialInterface::SIDEVICE_WIIU_ADAPTER)
+    return GCAdapter::Input(local_pad);
+
+  return Pad::GetStatus(local_pad);
+}
+
+bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
+{
+  const int ingame_pad = LocalPadToInGamePad(local_pad);
+  bool data_added = false;
+  const GCPadStatus pad_status = GetLocalPadStatus(local_pad);
 
   if (m_host_input_authority)
   {
@@ -2522,6 +2664,10 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
+  // Frames that get simulated again after a rollback would be reported twice
+  if (netplay_client->m_rollback_active)
+    return;
+
   if (netplay_client->m_timebase_frame % 60 == 0)
   {
     const sf::Uint64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -21,11 +22,17 @@
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
 class BootSessionData;
 
+namespace Core
+{
+class System;
+}
+
 namespace IOS::HLE::FS
 {
 class FileSystem;
@@ -224,6 +231,18 @@ protected:
   bool m_host_input_authority = false;
   PlayerId m_current_golfer = 1;
 
+  // In rollback mode, GameCube controller inputs go through m_rollback instead of being delayed
+  // by the pad buffers, and the state at the start of each frame that can still be rolled back is
+  // kept in m_rollback_states.
+  //
+  // Pads are polled in the middle of emulation, where savestates can't be saved or loaded, so the
+  // polls only request them, and RunRollbackJob does the work once the CPU thread has left the run
+  // loop. All of this is guarded by crit_netplay_client.
+  bool m_rollback_active = false;
+  RollbackController m_rollback;
+  std::array<std::vector<u8>, RollbackController::STATE_COUNT> m_rollback_states;
+  bool m_rollback_job_queued = false;
+
   // This bool will stall the client at the start of GetNetPads, used for switching input control
   // without deadlocking. Use the correspondingly named Event to wake it up.
   bool m_wait_on_input;
@@ -256,7 +275,12 @@ private:
   void SyncSaveDataResponse(bool success);
   void SyncCodeResponse(bool success);
 
+  GCPadStatus GetLocalPadStatus(int local_pad) const;
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool StartRollbackFrame();
+  void QueueRollbackJob();
+  void RunRollbackJob(Core::System& system);
+  bool GetRollbackPads(int pad_nb, GCPadStatus* pad_status);
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
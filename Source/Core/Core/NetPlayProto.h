@@ -103,6 +103,7 @@ struct NetSettings
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  bool rollback = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
 
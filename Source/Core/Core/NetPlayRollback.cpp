@@ -0,0 +1,187 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+void RollbackInputs::Reset(const std::array<PadSource, 4>& sources)
+{
+  for (size_t i = 0; i < m_pads.size(); ++i)
+  {
+    m_pads[i] = {};
+    m_pads[i].source = sources[i];
+  }
+  m_next_frame = 0;
+  m_present_frame = 0;
+  m_mispredicted_frame.reset();
+}
+
+bool RollbackInputs::NeedsLocalInputs() const
+{
+  return std::ranges::any_of(m_pads, [this](const Pad& pad) {
+    return pad.source == PadSource::Local && pad.confirmed_frames == m_present_frame;
+  });
+}
+
+void RollbackInputs::AddLocalInput(int pad_index, const GCPadStatus& status)
+{
+  Pad& pad = m_pads[pad_index];
+  ASSERT(pad.source == PadSource::Local && pad.confirmed_frames == m_present_frame);
+
+  pad.confirmed[pad.confirmed_frames % HISTORY_SIZE] = status;
+  ++pad.confirmed_frames;
+}
+
+void RollbackInputs::AddRemoteInput(int pad_index, const GCPadStatus& status)
+{
+  Pad& pad = m_pads[pad_index];
+  const u64 frame = pad.confirmed_frames;
+  const u64 slot = frame % HISTORY_SIZE;
+
+  pad.confirmed[slot] = status;
+  ++pad.confirmed_frames;
+
+  if (frame < m_next_frame && pad.predicted[slot] && pad.used[slot] != status)
+    m_mispredicted_frame = std::min(m_mispredicted_frame.value_or(frame), frame);
+}
+
+bool RollbackInputs::CanSimulateNextFrame() const
+{
+  return std::ranges::all_of(m_pads, [this](const Pad& pad) {
+    return pad.source != PadSource::Remote ||
+           m_next_frame < pad.confirmed_frames + MAX_ROLLBACK_FRAMES;
+  });
+}
+
+bool RollbackInputs::IsNextFrameConfirmed() const
+{
+  return std::ranges::all_of(m_pads, [this](const Pad& pad) {
+    return pad.source != PadSource::Remote || m_next_frame < pad.confirmed_frames;
+  });
+}
+
+std::optional<u64> RollbackInputs::TakeMispredictedFrame()
+{
+  return std::exchange(m_mispredicted_frame, std::nullopt);
+}
+
+std::array<GCPadStatus, 4> RollbackInputs::SimulateNextFrame()
+{
+  const u64 frame = m_next_frame;
+  const u64 slot = frame % HISTORY_SIZE;
+
+  std::array<GCPadStatus, 4> inputs;
+  for (size_t i = 0; i < m_pads.size(); ++i)
+  {
+    Pad& pad = m_pads[i];
+    ASSERT(pad.source != PadSource::Local || frame < pad.confirmed_frames);
+
+    pad.predicted[slot] = frame >= pad.confirmed_frames;
+    pad.used[slot] = pad.predicted[slot] ? Predict(pad) : pad.confirmed[slot];
+    inputs[i] = pad.used[slot];
+  }
+
+  ++m_next_frame;
+  m_present_frame = std::max(m_present_frame, m_next_frame);
+  return inputs;
+}
+
+void RollbackInputs::RollBack(u64 frame)
+{
+  ASSERT(frame < m_next_frame && frame + MAX_ROLLBACK_FRAMES >= m_next_frame);
+  m_next_frame = frame;
+}
+
+GCPadStatus RollbackInputs::Predict(const Pad& pad) const
+{
+  if (pad.confirmed_frames != 0)
+    return pad.confirmed[(pad.confirmed_frames - 1) % HISTORY_SIZE];
+
+  GCPadStatus neutral;
+  neutral.stickX = GCPadStatus::MAIN_STICK_CENTER_X;
+  neutral.stickY = GCPadStatus::MAIN_STICK_CENTER_Y;
+  neutral.substickX = GCPadStatus::C_STICK_CENTER_X;
+  neutral.substickY = GCPadStatus::C_STICK_CENTER_Y;
+  return neutral;
+}
+
+void RollbackController::Reset(const std::array<RollbackInputs::PadSource, 4>& sources)
+{
+  m_inputs.Reset(sources);
+  m_frame_inputs = {};
+  m_saved_frames = {};
+  m_pending_rollback.reset();
+}
+
+RollbackController::PollResult RollbackController::Poll()
+{
+  if (const std::optional<u64> frame = m_inputs.TakeMispredictedFrame())
+    m_pending_rollback = std::min(m_pending_rollback.value_or(*frame), *frame);
+
+  if (m_pending_rollback)
+    return PollResult::RepeatFrame;
+
+  // Don't get further ahead of a remote player than we can roll back, and don't predict inputs
+  // for a frame whose state hasn't been saved
+  if (!m_inputs.CanSimulateNextFrame() ||
+      !(m_inputs.IsNextFrameConfirmed() || IsStateSaved(m_inputs.GetNextFrame())))
+  {
+    return PollResult::Wait;
+  }
+
+  m_frame_inputs = m_inputs.SimulateNextFrame();
+  return PollResult::NextFrame;
+}
+
+bool RollbackController::HasStateRequest() const
+{
+  return m_pending_rollback || !IsStateSaved(m_inputs.GetNextFrame());
+}
+
+RollbackController::StateRequest RollbackController::TakeStateRequest()
+{
+  if (const std::optional<u64> frame = std::exchange(m_pending_rollback, std::nullopt))
+  {
+    // Predictions are only made for frames whose state was saved
+    ASSERT(IsStateSaved(*frame));
+    m_inputs.RollBack(*frame);
+
+    // The states of later frames were simulated with the wrong inputs
+    for (std::optional<u64>& saved_frame : m_saved_frames)
+    {
+      if (saved_frame && *saved_frame > *frame)
+        saved_frame.reset();
+    }
+    return {StateRequest::Type::Load, *frame};
+  }
+
+  const u64 frame = m_inputs.GetNextFrame();
+  if (IsStateSaved(frame))
+    return {};
+
+  // The slot is about to be overwritten
+  m_saved_frames[GetStateSlot(frame)].reset();
+  return {StateRequest::Type::Save, frame};
+}
+
+void RollbackController::StateSaved(u64 frame, bool success)
+{
+  if (success)
+    m_saved_frames[GetStateSlot(frame)] = frame;
+}
+
+bool RollbackController::IsStateSaved(u64 frame) const
+{
+  return m_saved_frames[GetStateSlot(frame)] == frame;
+}
+}  // namespace NetPlay
@@ -0,0 +1,157 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Keeps track of the GameCube controller inputs of the frames that can still be rolled back, for
+// the rollback network mode.
+//
+// Local inputs are used as soon as they are polled. Remote inputs that haven't arrived yet are
+// predicted to stay the same as the last one that did, and once the real input arrives and turns
+// out to be different, the frames since then have to be simulated again.
+class RollbackInputs
+{
+public:
+  // How many frames ahead of the slowest remote input the simulation may run. This is also the
+  // number of savestates that need to be kept.
+  static constexpr u64 MAX_ROLLBACK_FRAMES = 8;
+
+  enum class PadSource
+  {
+    None,
+    Local,
+    Remote,
+  };
+
+  void Reset(const std::array<PadSource, 4>& sources);
+
+  // The first frame that hasn't been simulated yet.
+  u64 GetNextFrame() const { return m_next_frame; }
+  // The first frame that has never been simulated. This is only larger than the next frame while
+  // frames are simulated again after a rollback.
+  u64 GetPresentFrame() const { return m_present_frame; }
+  bool IsResimulating() const { return m_next_frame < m_present_frame; }
+
+  // Whether the local pads still need their inputs for the present frame.
+  bool NeedsLocalInputs() const;
+  // Adds the input of a local pad for the present frame.
+  void AddLocalInput(int pad, const GCPadStatus& status);
+  // Adds the next input of a remote pad. Remote inputs arrive in frame order.
+  void AddRemoteInput(int pad, const GCPadStatus& status);
+
+  // Whether the next frame can be simulated without predicting more than MAX_ROLLBACK_FRAMES
+  // inputs of any remote pad.
+  bool CanSimulateNextFrame() const;
+  // Whether the inputs of all remote pads for the next frame have arrived, so that simulating it
+  // doesn't need a prediction that could require rolling it back.
+  bool IsNextFrameConfirmed() const;
+
+  // The earliest simulated frame that used a wrong prediction, if any. Simulation has to continue
+  // from the state that was saved at the start of that frame.
+  std::optional<u64> TakeMispredictedFrame();
+
+  // Uses the confirmed or predicted inputs for the next frame, and advances to the frame after it.
+  std::array<GCPadStatus, 4> SimulateNextFrame();
+
+  // Goes back to a frame that was simulated before.
+  void RollBack(u64 frame);
+
+private:
+  // Large enough for the inputs of the frames that can be rolled back, and for the remote inputs
+  // that arrive before the frames they belong to.
+  static constexpr u64 HISTORY_SIZE = 4 * MAX_ROLLBACK_FRAMES;
+
+  struct Pad
+  {
+    PadSource source = PadSource::None;
+    // The number of inputs that have arrived, which is also the first frame without an input.
+    u64 confirmed_frames = 0;
+    std::array<GCPadStatus, HISTORY_SIZE> confirmed{};
+    std::array<GCPadStatus, HISTORY_SIZE> used{};
+    std::array<bool, HISTORY_SIZE> predicted{};
+  };
+
+  GCPadStatus Predict(const Pad& pad) const;
+
+  std::array<Pad, 4> m_pads;
+  u64 m_next_frame = 0;
+  u64 m_present_frame = 0;
+  std::optional<u64> m_mispredicted_frame;
+};
+
+// Decides what the first pad poll of each frame does in the rollback mode, and which savestates
+// have to be saved or loaded.
+//
+// Polls happen in the middle of a block, where states can't be saved or loaded. The poll only
+// requests them, and the CPU thread takes the request once it has left the run loop, which is
+// always before the next poll. A poll never waits for a state: a frame only uses predicted inputs
+// if the state at its start has been saved, and otherwise waits for the remote inputs.
+class RollbackController
+{
+public:
+  // One more state than frames that can be rolled back, so that saving the state of the newest
+  // frame doesn't overwrite the one a pending rollback needs.
+  static constexpr size_t STATE_COUNT = RollbackInputs::MAX_ROLLBACK_FRAMES + 1;
+
+  enum class PollResult
+  {
+    // The remote inputs needed to start the next frame haven't arrived yet.
+    Wait,
+    // The next frame starts with the inputs from GetFrameInputs.
+    NextFrame,
+    // A rollback is pending, and whatever is simulated until it happens is thrown away, so the
+    // inputs of the last frame are used again.
+    RepeatFrame,
+  };
+
+  struct StateRequest
+  {
+    enum class Type
+    {
+      None,
+      Save,
+      Load,
+    };
+
+    Type type = Type::None;
+    // The frame that starts right after the state.
+    u64 frame = 0;
+  };
+
+  static size_t GetStateSlot(u64 frame) { return frame % STATE_COUNT; }
+
+  void Reset(const std::array<RollbackInputs::PadSource, 4>& sources);
+
+  RollbackInputs& GetInputs() { return m_inputs; }
+  const RollbackInputs& GetInputs() const { return m_inputs; }
+
+  // To be called on the first pad poll of a frame, after adding the inputs that have arrived.
+  PollResult Poll();
+  const std::array<GCPadStatus, 4>& GetFrameInputs() const { return m_frame_inputs; }
+
+  // Whether a state has to be saved or loaded before the next poll.
+  bool HasStateRequest() const;
+  // For a load, the inputs have already been rolled back to the frame of the state when this
+  // returns.
+  StateRequest TakeStateRequest();
+  void StateSaved(u64 frame, bool success);
+
+private:
+  bool IsStateSaved(u64 frame) const;
+
+  RollbackInputs m_inputs;
+  std::array<GCPadStatus, 4> m_frame_inputs{};
+  // For each state slot, the frame that starts right after the state, if the state is valid.
+  std::array<std::optional<u64>, STATE_COUNT> m_saved_frames;
+  std::optional<u64> m_pending_rollback;
+};
+}  // namespace NetPlay
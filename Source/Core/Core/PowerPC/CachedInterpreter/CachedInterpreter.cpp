@@ -110,7 +110,7 @@ void CachedInterpreter::ExecuteOneBlock()
   const u8* normal_entry = m_block_cache.Dispatch();
   if (!normal_entry)
   {
-    Jit(m_ppc_state.pc);
+    JitTimed(m_ppc_state.pc);
     return;
   }
 
@@ -157,7 +157,7 @@ void CachedInterpreter::Run()
   auto& cpu = m_system.GetCPU();
 
   const CPU::State* state_ptr = cpu.GetStatePtr();
-  while (cpu.GetState() == CPU::State::Running)
+  while (*state_ptr == CPU::State::Running)
   {
     // Start new timing slice
     // NOTE: Exceptions may change PC
@@ -262,7 +262,7 @@ bool CachedInterpreter::CheckIdle(CachedInterpreter& cached_interpreter, u32 idl
 {
   if (cached_interpreter.m_ppc_state.npc == idle_pc)
   {
-    cached_interpreter.m_system.GetCoreTiming().Idle();
+    cached_interpreter.m_system.GetCoreTiming().SkipIdleLoop(idle_pc);
   }
   return false;
 }
@@ -16,6 +16,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/Debugger/CodeTraceRecorder.h"
 #include "Core/Debugger/Debugger_SymbolMap.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
@@ -65,9 +66,10 @@ void Interpreter::UpdatePC()
 }
 
 Interpreter::Interpreter(Core::System& system, PowerPC::PowerPCState& ppc_state, PowerPC::MMU& mmu,
-                         Core::BranchWatch& branch_watch, PPCSymbolDB& ppc_symbol_db)
+                         Core::BranchWatch& branch_watch,
+                         Core::CodeTraceRecorder& code_trace_recorder, PPCSymbolDB& ppc_symbol_db)
     : m_system(system), m_ppc_state(ppc_state), m_mmu(mmu), m_branch_watch(branch_watch),
-      m_ppc_symbol_db(ppc_symbol_db)
+      m_code_trace_recorder(code_trace_recorder), m_ppc_symbol_db(ppc_symbol_db)
 {
 }
 
@@ -118,6 +120,23 @@ bool Interpreter::HandleFunctionHooking(u32 address)
   return result.type != HLE::HookType::Start;
 }
 
+void Interpreter::RunOp(bool trace)
+{
+  // Instructions that fault don't access memory or write registers, so they aren't traced.
+  constexpr u32 FAULTS = EXCEPTION_DSI | EXCEPTION_ALIGNMENT;
+  const u32 previous_faults = m_ppc_state.Exceptions & FAULTS;
+
+  RunInterpreterOp(*this, m_prev_inst);
+
+  if (trace && (m_ppc_state.Exceptions & FAULTS) == previous_faults)
+    m_code_trace_recorder.CommitRecord();
+
+  if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
+  {
+    CheckExceptions();
+  }
+}
+
 int Interpreter::SingleStepInner()
 {
   if (HandleFunctionHooking(m_ppc_state.pc))
@@ -150,6 +169,10 @@ int Interpreter::SingleStepInner()
     Trace(m_prev_inst);
   }
 
+  const bool trace = m_code_trace_recorder.IsRecording() && m_prev_inst.hex != 0;
+  if (trace)
+    m_code_trace_recorder.Record(m_ppc_state, m_prev_inst, *opinfo);
+
   if (m_prev_inst.hex != 0)
   {
     if (IsInvalidPairedSingleExecution(m_prev_inst))
@@ -159,11 +182,7 @@ int Interpreter::SingleStepInner()
     }
     else if (m_ppc_state.msr.FP)
     {
-      RunInterpreterOp(*this, m_prev_inst);
-      if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
-      {
-        CheckExceptions();
-      }
+      RunOp(trace);
     }
     else
     {
@@ -175,11 +194,7 @@ int Interpreter::SingleStepInner()
       }
       else
       {
-        RunInterpreterOp(*this, m_prev_inst);
-        if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
-        {
-          CheckExceptions();
-        }
+        RunOp(trace);
       }
     }
   }
@@ -231,7 +246,8 @@ void Interpreter::Run()
   auto& core_timing = m_system.GetCoreTiming();
   auto& cpu = m_system.GetCPU();
   auto& power_pc = m_system.GetPowerPC();
-  while (cpu.GetState() == CPU::State::Running)
+  const CPU::State* state_ptr = cpu.GetStatePtr();
+  while (*state_ptr == CPU::State::Running)
   {
     // CoreTiming Advance() ends the previous slice and declares the start of the next
     // one so it must always be called at the start. At boot, we are in slice -1 and must
@@ -12,6 +12,7 @@
 namespace Core
 {
 class BranchWatch;
+class CodeTraceRecorder;
 class System;
 }  // namespace Core
 namespace PowerPC
@@ -25,7 +26,8 @@ class Interpreter : public CPUCoreBase
 {
 public:
   Interpreter(Core::System& system, PowerPC::PowerPCState& ppc_state, PowerPC::MMU& mmu,
-              Core::BranchWatch& branch_watch, PPCSymbolDB& ppc_symbol_db);
+              Core::BranchWatch& branch_watch, Core::CodeTraceRecorder& code_trace_recorder,
+              PPCSymbolDB& ppc_symbol_db);
   Interpreter(const Interpreter&) = delete;
   Interpreter(Interpreter&&) = delete;
   Interpreter& operator=(const Interpreter&) = delete;
@@ -296,6 +298,8 @@ public:
 
 private:
   void CheckExceptions();
+  // Runs m_prev_inst, and commits its code trace record if it didn't fault.
+  void RunOp(bool trace);
 
   bool HandleFunctionHooking(u32 address);
 
@@ -318,6 +322,7 @@ private:
   PowerPC::PowerPCState& m_ppc_state;
   PowerPC::MMU& m_mmu;
   Core::BranchWatch& m_branch_watch;
+  Core::CodeTraceRecorder& m_code_trace_recorder;
   PPCSymbolDB& m_ppc_symbol_db;
 
   UGeckoInstruction m_prev_inst{};
@@ -152,6 +152,7 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
                    ctx->CTX_PC, access_address, memory_base, ppc_state.msr.DR);
     }
 
+    ++m_fastmem_fault_count;
     return BackPatch(ctx);
   }
 
@@ -299,6 +300,7 @@ void Jit64::Init()
 void Jit64::ClearCache()
 {
   blocks.Clear();
+  m_branch_watch.ResetCounters();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
@@ -649,7 +651,7 @@ void Jit64::WriteRfiExitDestInRSCRATCH()
 void Jit64::WriteIdleExit(u32 destination)
 {
   ABI_PushRegistersAndAdjustStack({}, 0);
-  ABI_CallFunction(CoreTiming::GlobalIdle);
+  ABI_CallFunctionC(CoreTiming::GlobalIdle, destination);
   ABI_PopRegistersAndAdjustStack({}, 0);
   MOV(32, PPCSTATE(pc), Imm32(destination));
   WriteExceptionExit();
@@ -75,6 +75,16 @@ void Jit64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst
   MOVZX(32, 8, reg_b, MDisp(reg_a, Core::BranchWatch::GetOffsetOfRecordingActive()));
   TEST(32, R(reg_b), R(reg_b));
 
+  if (u64* const counter =
+          m_branch_watch.GetCounter(origin, destination, inst, m_ppc_state.msr.IR, condition))
+  {
+    FixupBranch branch_over = J_CC(CC_Z);
+    MOV(64, R(reg_a), ImmPtr(counter));
+    ADD(64, MatR(reg_a), Imm8(1));
+    SetJumpTarget(branch_over);
+    return;
+  }
+
   FixupBranch branch_in = J_CC(CC_NZ, Jump::Near);
   SwitchToFarCode();
   SetJumpTarget(branch_in);
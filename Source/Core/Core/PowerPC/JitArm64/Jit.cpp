@@ -142,6 +142,7 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
       }
       else
       {
+        ++m_fastmem_fault_count;
         success = HandleFastmemFault(ctx);
       }
     }
@@ -160,6 +161,7 @@ void JitArm64::ClearCache()
   m_fault_to_handler.clear();
 
   blocks.Clear();
+  m_branch_watch.ResetCounters();
   blocks.ClearRangesToFree();
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
   m_far_code_0.ClearCodeSpace();
@@ -84,6 +84,18 @@ void JitArm64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction i
   LDRB(IndexType::Unsigned, reg_b, branch_watch, Core::BranchWatch::GetOffsetOfRecordingActive());
   FixupBranch branch_over = CBZ(reg_b);
 
+  if (u64* const counter =
+          m_branch_watch.GetCounter(origin, destination, inst, m_ppc_state.msr.IR, condition))
+  {
+    const ARM64Reg hits = EncodeRegTo64(reg_b);
+    MOVP2R(branch_watch, counter);
+    LDR(IndexType::Unsigned, hits, branch_watch, 0);
+    ADD(hits, hits, 1);
+    STR(IndexType::Unsigned, hits, branch_watch, 0);
+    SetJumpTarget(branch_over);
+    return;
+  }
+
   FixupBranch branch_in = B();
   SwitchToFarCode();
   SetJumpTarget(branch_in);
@@ -194,10 +206,7 @@ void JitArm64::bx(UGeckoInstruction inst)
     }
 
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
     gpr.Unlock(WA);
 
     WriteExceptionExit(js.op->branchTo);
@@ -274,10 +283,7 @@ void JitArm64::bcx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
@@ -435,10 +441,7 @@ void JitArm64::bclrx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
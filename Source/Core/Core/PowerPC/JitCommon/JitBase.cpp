@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <utility>
 
 #include "Common/Align.h"
@@ -83,6 +84,13 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitB
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
 }};
 
+void JitBase::JitTimed(u32 em_address)
+{
+  const auto start = std::chrono::steady_clock::now();
+  Jit(em_address);
+  m_compile_time += std::chrono::steady_clock::now() - start;
+}
+
 const u8* JitBase::Dispatch(JitBase& jit)
 {
   return jit.GetBlockCache()->Dispatch();
@@ -90,7 +98,7 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
-  jit.Jit(em_address);
+  jit.JitTimed(em_address);
 }
 
 JitBase::JitBase(Core::System& system)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <unordered_set>
@@ -162,6 +163,12 @@ protected:
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
+  // Fastmem accesses that faulted and were sent to the slow path.
+  u64 m_fastmem_fault_count = 0;
+
+  // Host time spent in Jit() when called through JitTimed().
+  std::chrono::nanoseconds m_compile_time{};
+
   static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh();
@@ -193,11 +200,15 @@ public:
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
+  // Calls Jit() and adds the time it took to the compile time.
+  void JitTimed(u32 em_address);
+  std::chrono::nanoseconds GetCompileTime() const { return m_compile_time; }
 
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
   bool HandleStackFault();
+  u64 GetFastmemFaultCount() const { return m_fastmem_fault_count; }
 
   static constexpr std::size_t code_buffer_size = 32000;
 
@@ -12,9 +12,13 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -182,6 +186,59 @@ void JitInterface::JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE*
   }
 }
 
+void JitInterface::JitProfileDump(const Core::CPUThreadGuard& guard, std::FILE* file) const
+{
+  if (!m_jit || !m_jit->IsProfilingEnabled())
+    return;
+
+  u64 sample = 0;
+  m_jit->GetBlockCache()->RunOnBlocks(guard, [&](const JitBlock& block) {
+    const JitBlock::ProfileData* const data = block.profile_data.get();
+    if (data->cycles_spent == 0)
+      return;
+
+    // The timestamps only keep the samples in order.
+    fmt::print(file, "dolphin 0/0 [000] {}.{:06}: {} cycles:\n", sample / 1000000,
+               sample % 1000000, data->cycles_spent);
+    ++sample;
+
+    const Common::Symbol* const symbol =
+        m_jit->m_ppc_symbol_db.GetSymbolFromAddr(block.effectiveAddress);
+    if (symbol)
+    {
+      fmt::print(file, "\t{:x} {}+{:#x} (guest)\n\n", block.effectiveAddress, symbol->name,
+                 block.effectiveAddress - symbol->address);
+    }
+    else
+    {
+      fmt::print(file, "\t{:x} [unknown] (guest)\n\n", block.effectiveAddress);
+    }
+  });
+}
+
+void JitInterface::WriteConfiguredJitProfile(const Core::CPUThreadGuard& guard) const
+{
+  const std::string path = Config::Get(Config::MAIN_DEBUG_JIT_PROFILE_OUTPUT);
+  if (path.empty() || !m_jit)
+    return;
+
+  if (!m_jit->IsProfilingEnabled())
+  {
+    WARN_LOG_FMT(DYNA_REC, "Not writing the JIT profile to {}: JIT profiling is disabled", path);
+    return;
+  }
+
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(DYNA_REC, "Failed to open {} for writing the JIT profile", path);
+    return;
+  }
+
+  JitProfileDump(guard, file.GetHandle());
+  NOTICE_LOG_FMT(DYNA_REC, "Wrote the JIT profile to {}", path);
+}
+
 std::variant<JitInterface::GetHostCodeError, JitInterface::GetHostCodeResult>
 JitInterface::GetHostCode(u32 address) const
 {
@@ -235,6 +292,18 @@ bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
   return m_jit->HandleFault(access_address, ctx);
 }
 
+JitInterface::FastmemStats JitInterface::GetFastmemStats() const
+{
+  const Memory::LogicalMemoryStats& logical = m_system.GetMemory().GetLogicalMemoryStats();
+  return FastmemStats{logical.updates, logical.pages_mapped, logical.pages_unmapped,
+                      m_jit ? m_jit->GetFastmemFaultCount() : 0};
+}
+
+std::chrono::nanoseconds JitInterface::GetCompileTime() const
+{
+  return m_jit ? m_jit->GetCompileTime() : std::chrono::nanoseconds{};
+}
+
 bool JitInterface::HandleStackFault()
 {
   if (!m_jit)
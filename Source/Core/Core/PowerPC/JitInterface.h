@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
@@ -57,12 +58,32 @@ public:
 
   void UpdateMembase();
   void JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
+  // Writes the cycles spent in each block in the text format of `perf script`, with one sample per
+  // block weighted by its cycles and named after the guest symbol, for flame graph tools.
+  // Requires JIT profiling to be enabled.
+  void JitProfileDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
+  // Writes the dump above to the file set in MAIN_DEBUG_JIT_PROFILE_OUTPUT, if any.
+  void WriteConfiguredJitProfile(const Core::CPUThreadGuard& guard) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
   // Memory Utilities
   bool HandleFault(uintptr_t access_address, SContext* ctx);
   bool HandleStackFault();
 
+  struct FastmemStats
+  {
+    // DBAT updates, and the BAT pages they mapped into or unmapped from the logical fastmem region.
+    u64 logical_memory_updates;
+    u64 logical_pages_mapped;
+    u64 logical_pages_unmapped;
+    // Fastmem accesses of the current JIT that faulted and were backpatched to the slow path.
+    u64 faults;
+  };
+  FastmemStats GetFastmemStats() const;
+
+  // Host time the current JIT has spent compiling blocks.
+  std::chrono::nanoseconds GetCompileTime() const;
+
   // Clearing CodeCache
   void ClearCache(const Core::CPUThreadGuard& guard);
 
@@ -1324,6 +1324,8 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  InvalidateTLBShadow();
 }
 
 enum class TLBLookupResult
@@ -1413,6 +1415,48 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+  InvalidateTLBShadowSet(PowerPC::DATA_TLB_INDEX, entry_index);
+  InvalidateTLBShadowSet(PowerPC::INST_TLB_INDEX, entry_index);
+}
+
+void MMU::FillTLBShadow(size_t tlb_index, u32 tag, u32 vsid)
+{
+  const TLBEntry& tlbe = m_ppc_state.tlb[tlb_index][tag & HW_PAGE_INDEX_MASK];
+  u32 way = 0;
+  while (tlbe.tag[way] != tag || tlbe.vsid[way] != vsid)
+  {
+    if (++way == TLB_WAYS)
+      return;
+  }
+  const UPTE_Hi pte2(tlbe.pte[way]);
+
+  TLBShadowEntry& entry = m_tlb_shadow[tlb_index][tag % TLB_SHADOW_SIZE];
+  entry.generation = m_tlb_shadow_generation;
+  entry.tag = tag;
+  entry.vsid = tlbe.vsid[way];
+  entry.paddr = tlbe.paddr[way];
+  entry.way = static_cast<u8>(way);
+  entry.wi = (pte2.WIMG & 0b1100) != 0;
+  entry.changed = pte2.C != 0;
+}
+
+// Drops the shadow entries of all pages that share a TLB set with the given page.
+void MMU::InvalidateTLBShadowSet(size_t tlb_index, u32 tag)
+{
+  static_assert(TLB_SHADOW_SIZE % (HW_PAGE_INDEX_MASK + 1) == 0);
+  for (u32 i = tag & HW_PAGE_INDEX_MASK; i < TLB_SHADOW_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+    m_tlb_shadow[tlb_index][i] = {};
+}
+
+void MMU::InvalidateTLBShadow()
+{
+  if (++m_tlb_shadow_generation == 0)
+  {
+    // Entries from before the wraparound would otherwise become valid again.
+    for (auto& shadow : m_tlb_shadow)
+      shadow.fill({});
+    m_tlb_shadow_generation = 1;
+  }
 }
 
 // Page Address Translation
@@ -1421,6 +1465,23 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
 {
   const auto sr = UReg_SR{m_ppc_state.sr[address.SR]};
   const u32 VSID = sr.VSID;  // 24 bit
+  const u32 tag = address.Hex >> HW_PAGE_INDEX_SHIFT;
+  const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
+
+  // Host accesses don't update the TLB, so they don't use the shadow either.
+  if constexpr (!IsNoExceptionFlag(flag))
+  {
+    const TLBShadowEntry& entry = m_tlb_shadow[tlb_index][tag % TLB_SHADOW_SIZE];
+    if (entry.generation == m_tlb_shadow_generation && entry.tag == tag && entry.vsid == VSID &&
+        (flag != XCheckTLBFlag::Write || entry.changed))
+    {
+      ++m_tlb_stats.shadow_hits;
+      m_ppc_state.tlb[tlb_index][tag & HW_PAGE_INDEX_MASK].recent = entry.way;
+      *wi = entry.wi;
+      return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                    entry.paddr | address.offset};
+    }
+  }
 
   // TLB cache
   // This catches 99%+ of lookups in practice, so the actual page table entry code below doesn't
@@ -1430,6 +1491,11 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
       LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID, &translated_address, wi);
   if (res == TLBLookupResult::Found)
   {
+    if constexpr (!IsNoExceptionFlag(flag))
+    {
+      ++m_tlb_stats.tlb_hits;
+      FillTLBShadow(tlb_index, tag, VSID);
+    }
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                   translated_address};
   }
@@ -1442,9 +1508,14 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
   // No-execute segment register flag.
   if ((flag == XCheckTLBFlag::Opcode || flag == XCheckTLBFlag::OpcodeNoException) && sr.N != 0)
   {
+    if constexpr (!IsNoExceptionFlag(flag))
+      ++m_tlb_stats.page_faults;
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
   }
 
+  if constexpr (!IsNoExceptionFlag(flag))
+    ++m_tlb_stats.page_table_walks;
+
   const u32 offset = address.offset;          // 12 bit
   const u32 page_index = address.page_index;  // 16 bit
   const u32 api = address.API;                //  6 bit (part of page_index)
@@ -1505,6 +1576,13 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
         if (res != TLBLookupResult::UpdateC)
           UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex, VSID);
 
+        // The refill may have replaced a way the shadow still points to.
+        if constexpr (!IsNoExceptionFlag(flag))
+        {
+          InvalidateTLBShadowSet(tlb_index, tag);
+          FillTLBShadow(tlb_index, tag, VSID);
+        }
+
         *wi = (pte2.WIMG & 0b1100) != 0;
 
         return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
@@ -1512,6 +1590,9 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
       }
     }
   }
+
+  if constexpr (!IsNoExceptionFlag(flag))
+    ++m_tlb_stats.page_faults;
   return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
 }
 
@@ -1642,6 +1723,7 @@ void MMU::DBATUpdated()
 #ifndef _ARCH_32
   m_memory.UpdateLogicalMemory(m_dbat_table);
 #endif
+  InvalidateTLBShadow();
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   m_system.GetJitInterface().ClearSafe();
@@ -1660,6 +1742,7 @@ void MMU::IBATUpdated()
     UpdateFakeMMUBat(m_ibat_table, 0x40000000);
     UpdateFakeMMUBat(m_ibat_table, 0x70000000);
   }
+  InvalidateTLBShadow();
   m_system.GetJitInterface().ClearSafe();
 }
 
@@ -241,6 +241,23 @@ public:
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
+  // Must be called whenever the TLB in PowerPCState is replaced.
+  void InvalidateTLBShadow();
+
+  // Counters for page table translations done on behalf of the emulated CPU. Accesses translated
+  // by a BAT aren't counted.
+  struct TLBStats
+  {
+    // Translations found in the TLB shadow
+    u64 shadow_hits = 0;
+    // Translations that missed the shadow but were found in the TLB
+    u64 tlb_hits = 0;
+    // Translations that missed the TLB and were looked up in the page table
+    u64 page_table_walks = 0;
+    // Page table walks that didn't find a translation
+    u64 page_faults = 0;
+  };
+  const TLBStats& GetTLBStats() const { return m_tlb_stats; }
 
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
@@ -297,6 +314,9 @@ private:
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslatePageAddress(const EffectiveAddress address, bool* wi);
 
+  void FillTLBShadow(size_t tlb_index, u32 tag, u32 vsid);
+  void InvalidateTLBShadowSet(size_t tlb_index, u32 tag);
+
   void GenerateDSIException(u32 effective_address, bool write);
   void GenerateISIException(u32 effective_address);
 
@@ -326,6 +346,36 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  // Direct-mapped view of the translations held by the emulated TLB, indexed by more bits of the
+  // effective page number than the TLB itself, so that a hit takes a single compare instead of
+  // checking both ways. Entries are only filled from the TLB, so a hit behaves exactly like a TLB
+  // hit. The entries of a TLB set are dropped when tlbie or a refill changes the set, and all
+  // entries are dropped by bumping the generation when SDR1 or a BAT changes, and when the TLB is
+  // reset or loaded from a savestate.
+  //
+  // Segment register writes and MSR changes are often made by JIT code without calling into the
+  // MMU. Each entry stores the VSID it was filled for, which the lookup compares against the
+  // current segment register, and the shadow is only used once MSR.IR or MSR.DR and the BATs
+  // have been checked, so neither needs to invalidate it.
+  struct TLBShadowEntry
+  {
+    u32 generation = 0;
+    u32 tag = 0;
+    u32 vsid = 0;
+    u32 paddr = 0;
+    u8 way = 0;
+    bool wi = false;
+    // The C bit is set already, so writes don't have to update the page table.
+    bool changed = false;
+  };
+
+  static constexpr size_t TLB_SHADOW_SIZE = 256;
+  static constexpr size_t TLB_SHADOW_COUNT = 2;  // data and instructions, like the TLB
+
+  std::array<std::array<TLBShadowEntry, TLB_SHADOW_SIZE>, TLB_SHADOW_COUNT> m_tlb_shadow{};
+  u32 m_tlb_shadow_generation = 1;
+  TLBStats m_tlb_stats;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
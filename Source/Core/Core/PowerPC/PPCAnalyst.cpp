@@ -4,8 +4,11 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <future>
 #include <map>
+#include <optional>
 #include <queue>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -14,11 +17,14 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/ParallelUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HLE/HLE.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -207,6 +213,18 @@ static bool IsMtspr(UGeckoInstruction inst)
   return inst.OPCD == 31 && inst.SUBOP10 == 467;
 }
 
+static bool IsMcrf(UGeckoInstruction inst)
+{
+  return inst.OPCD == 19 && inst.SUBOP10 == 0;
+}
+
+// crclr and crset read the CR field they modify, but their result doesn't depend on it.
+static bool IsCrClearOrSet(UGeckoInstruction inst)
+{
+  return inst.OPCD == 19 && (inst.SUBOP10 == 193 || inst.SUBOP10 == 289) &&
+         inst.CRBA == inst.CRBD && inst.CRBB == inst.CRBD;
+}
+
 static bool IsSprInstructionUsingMmcr(UGeckoInstruction inst)
 {
   const u32 index = (inst.SPRU << 5) | (inst.SPRL & 0x1F);
@@ -275,6 +293,17 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
   return true;
 }
 
+static std::optional<u32> GetCallTarget(UGeckoInstruction instr, u32 addr)
+{
+  if (instr.OPCD != 18 || !instr.LK)  // bl
+    return std::nullopt;
+
+  u32 target = SignExt26(instr.LI << 2);
+  if (!instr.AA)
+    target += addr;
+  return target;
+}
+
 // Most functions that are relevant to analyze should be
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
@@ -282,33 +311,76 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 static void FindFunctionsFromBranches(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
                                       Common::SymbolDB* func_db)
 {
-  auto& mmu = guard.GetSystem().GetMMU();
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
+  constexpr size_t MIN_PAGES_PER_THREAD = 64;
+
+  struct Page
   {
-    const PowerPC::TryReadInstResult read_result = mmu.TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
+    u32 start;
+    u32 end;
+    const u8* code;
+    std::vector<u32> call_targets;
+  };
+
+  auto& system = guard.GetSystem();
+  auto& memory = system.GetMemory();
+  auto& mmu = system.GetMMU();
 
-    if (read_result.valid && PPCTables::IsValidInstruction(instr, addr))
+  // Translate each page once. Pages in RAM are then scanned on all threads. The others, such as
+  // the fake VMEM, can only be read through the MMU, so they are scanned here.
+  std::vector<Page> pages;
+  for (u64 addr = startAddr; addr < endAddr;)
+  {
+    const u64 page_end = std::min<u64>((addr | PowerPC::HW_PAGE_MASK) + 1, endAddr);
+    Page& page = pages.emplace_back(Page{static_cast<u32>(addr), static_cast<u32>(page_end)});
+    addr = page_end;
+
+    const PowerPC::TryReadInstResult read_result = mmu.TryReadInstruction(page.start);
+    if (!read_result.valid)
+      continue;
+
+    const std::span<const u8> ram = memory.TryGetSpanForAddress(read_result.physical_address);
+    if (ram.size() >= page.end - page.start)
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
-      {
-        if (instr.LK)  // bl
+      page.code = ram.data();
+      continue;
+    }
+
+    for (u32 page_addr = page.start; page_addr < page.end; page_addr += 4)
+    {
+      const PowerPC::TryReadInstResult result = mmu.TryReadInstruction(page_addr);
+      if (!result.valid)
+        continue;
+      if (const std::optional<u32> target = GetCallTarget(result.hex, page_addr))
+        page.call_targets.push_back(*target);
+    }
+  }
+
+  auto futures =
+      Common::RunInParallel(pages.size(), MIN_PAGES_PER_THREAD, [&pages](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j)
         {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::MMU::HostIsRAMAddress(guard, target))
+          Page& page = pages[j];
+          if (!page.code)
+            continue;
+
+          for (u32 addr = page.start; addr < page.end; addr += 4)
           {
-            func_db->AddFunction(guard, target);
+            const UGeckoInstruction instr = Common::swap32(page.code + (addr - page.start));
+            if (const std::optional<u32> target = GetCallTarget(instr, addr))
+              page.call_targets.push_back(*target);
           }
         }
-      }
-      break;
-      default:
-        break;
-      }
+      });
+  for (std::future<void>& future : futures)
+    future.get();
+
+  // Add the functions in address order, like a single scan would.
+  for (const Page& page : pages)
+  {
+    for (const u32 target : page.call_targets)
+    {
+      if (PowerPC::MMU::HostIsRAMAddress(guard, target))
+        func_db->AddFunction(guard, target);
     }
   }
 }
@@ -734,17 +806,19 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
+  //   * It loops to itself and does not contain any other branches, except for followed calls
+  //     to leaf functions and their returns.
   //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //   * It only reads from registers and CR fields it wrote to earlier in the loop, or it
+  //     does not write to these registers and CR fields.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
+  // A lot of the most used busy loops are DSP or VI register interactions, which are bl/cmp/bne
+  // with the bl target a pure function that follows the above rules. Branch following inlines
+  // these calls, so they are covered as long as the callee doesn't set up a stack frame.
   std::bitset<32> write_disallowed_regs;
   std::bitset<32> written_regs;
+  BitSet8 write_disallowed_crs;
+  BitSet8 written_crs;
   for (size_t i = 0; i <= instructions; ++i)
   {
     if (code[i].opinfo->type == OpType::Branch)
@@ -754,7 +828,8 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
       if (code[i].branchTo == block->m_address && i == instructions)
         return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load &&
+             code[i].opinfo->type != OpType::CR && !IsMcrf(code[i].inst))
     {
       // In the future, some subsets of other instruction types might get
       // supported. Right now, only try loops that have this very
@@ -779,6 +854,12 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
           return false;
         written_regs[reg] = true;
       }
+
+      if (!IsCrClearOrSet(code[i].inst))
+        write_disallowed_crs |= code[i].crIn & ~written_crs;
+      if (code[i].crOut & write_disallowed_crs)
+        return false;
+      written_crs |= code[i].crOut;
     }
   }
   return false;
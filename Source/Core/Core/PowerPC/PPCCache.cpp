@@ -108,6 +108,7 @@ void Cache::Reset()
 void InstructionCache::Reset(JitInterface& jit_interface)
 {
   Cache::Reset();
+  m_fetch_block = INVALID_FETCH_BLOCK;
   jit_interface.ClearSafe();
 }
 
@@ -128,6 +129,7 @@ void InstructionCache::Init(Memory::MemoryManager& memory)
   RefreshConfig();
 
   Cache::Init(memory);
+  m_fetch_block = INVALID_FETCH_BLOCK;
 }
 
 void Cache::Store(Memory::MemoryManager& memory, u32 addr)
@@ -381,9 +383,24 @@ u32 InstructionCache::ReadInstruction(Memory::MemoryManager& memory,
   if (!HID0(ppc_state).ICE || m_disable_icache)  // instruction cache is disabled
     return memory.Read_U32(addr);
 
-  u32 value;
-  Read(memory, addr, &value, sizeof(value), HID0(ppc_state).ILOCK);
-  return Common::swap32(value);
+  const u32 block = addr & ~31;
+  if (block != m_fetch_block || (valid[m_fetch_set] & (1U << m_fetch_way)) == 0 ||
+      addrs[m_fetch_set][m_fetch_way] != block)
+  {
+    const auto [set, way] = GetCache(memory, addr, HID0(ppc_state).ILOCK);
+    if (way == 0xff)
+    {
+      // Locked cache miss
+      m_fetch_block = INVALID_FETCH_BLOCK;
+      return memory.Read_U32(addr);
+    }
+
+    m_fetch_block = block;
+    m_fetch_set = set;
+    m_fetch_way = way;
+  }
+
+  return Common::swap32(data[m_fetch_set][m_fetch_way][(addr & 31) >> 2]);
 }
 
 void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& jit_interface,
@@ -415,6 +432,15 @@ void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& j
   jit_interface.InvalidateICacheLine(addr);
 }
 
+void InstructionCache::DoState(Memory::MemoryManager& memory, PointerWrap& p)
+{
+  Cache::DoState(memory, p);
+
+  // The loaded PLRU bits may not reflect the last fetch.
+  if (p.IsReadMode())
+    m_fetch_block = INVALID_FETCH_BLOCK;
+}
+
 void InstructionCache::RefreshConfig()
 {
   m_disable_icache = Config::Get(Config::MAIN_DISABLE_ICACHE);
@@ -75,6 +75,15 @@ struct InstructionCache : public Cache
 
   bool m_disable_icache = false;
 
+  // The cache block that the last instruction was fetched from. Instructions are mostly fetched
+  // sequentially, and fetching the same block again doesn't change the PLRU bits, so further
+  // fetches from it only need to check that the block is still in its way.
+  u32 m_fetch_block = INVALID_FETCH_BLOCK;
+  u32 m_fetch_set = 0;
+  u32 m_fetch_way = 0;
+
+  static constexpr u32 INVALID_FETCH_BLOCK = 0xffffffff;
+
   InstructionCache() = default;
   ~InstructionCache();
   u32 ReadInstruction(Memory::MemoryManager& memory, PowerPC::PowerPCState& ppc_state, u32 addr);
@@ -82,5 +91,7 @@ struct InstructionCache : public Cache
   void Init(Memory::MemoryManager& memory);
   void Reset(JitInterface& jit_interface);
   void RefreshConfig();
+
+  void DoState(Memory::MemoryManager& memory, PointerWrap& p);
 };
 }  // namespace PowerPC
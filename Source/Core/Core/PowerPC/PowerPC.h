@@ -14,6 +14,7 @@
 
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Debugger/BranchWatch.h"
+#include "Core/Debugger/CodeTraceRecorder.h"
 #include "Core/Debugger/PPCDebugInterface.h"
 #include "Core/PowerPC/BreakPoints.h"
 #include "Core/PowerPC/ConditionRegister.h"
@@ -299,6 +300,8 @@ public:
   const PPCSymbolDB& GetSymbolDB() const { return m_symbol_db; }
   Core::BranchWatch& GetBranchWatch() { return m_branch_watch; }
   const Core::BranchWatch& GetBranchWatch() const { return m_branch_watch; }
+  Core::CodeTraceRecorder& GetCodeTraceRecorder() { return m_code_trace_recorder; }
+  const Core::CodeTraceRecorder& GetCodeTraceRecorder() const { return m_code_trace_recorder; }
 
 private:
   void InitializeCPUCore(CPUCore cpu_core);
@@ -317,6 +320,7 @@ private:
   PPCSymbolDB m_symbol_db;
   PPCDebugInterface m_debug_interface;
   Core::BranchWatch m_branch_watch;
+  Core::CodeTraceRecorder m_code_trace_recorder;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
 
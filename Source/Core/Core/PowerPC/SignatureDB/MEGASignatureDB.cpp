@@ -6,13 +6,18 @@
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/ParallelUtil.h"
 #include "Common/StringUtil.h"
 
 #include "Core/PowerPC/MMU.h"
@@ -101,18 +106,12 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+bool Compare(std::span<const u32> code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
@@ -124,6 +123,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -143,6 +143,7 @@ bool MEGASignatureDB::Load(const std::string& file_path)
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
       m_signatures.push_back(std::move(sig));
+      AddToIndex(static_cast<u32>(m_signatures.size() - 1));
     }
     else
     {
@@ -158,21 +159,113 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
+void MEGASignatureDB::AddToIndex(u32 signature_index)
+{
+  const std::vector<u32>& code = m_signatures[signature_index].code;
+  SizeIndex& index = m_index[static_cast<u32>(code.size())];
+  if (code.empty() || code[0] == 0)
+    index.wildcard_first_instruction.push_back(signature_index);
+  else
+    index.by_first_instruction[code[0]].push_back(signature_index);
+}
+
+std::optional<u32> MEGASignatureDB::FindSignature(std::span<const u32> code) const
+{
+  const auto size_iter = m_index.find(static_cast<u32>(code.size()));
+  if (size_iter == m_index.end())
+    return std::nullopt;
+
+  const SizeIndex& index = size_iter->second;
+  std::span<const u32> exact;
+  if (!code.empty())
+  {
+    const auto iter = index.by_first_instruction.find(code[0]);
+    if (iter != index.by_first_instruction.end())
+      exact = iter->second;
+  }
+  const std::span<const u32> wildcard = index.wildcard_first_instruction;
+
+  // Try both lists of candidates in file order, so that the first signature in the file wins.
+  auto exact_iter = exact.begin();
+  auto wildcard_iter = wildcard.begin();
+  while (exact_iter != exact.end() || wildcard_iter != wildcard.end())
+  {
+    u32 candidate;
+    if (wildcard_iter == wildcard.end() ||
+        (exact_iter != exact.end() && *exact_iter < *wildcard_iter))
+    {
+      candidate = *exact_iter++;
+    }
+    else
+    {
+      candidate = *wildcard_iter++;
+    }
+
+    if (Compare(code, m_signatures[candidate]))
+      return candidate;
+  }
+  return std::nullopt;
+}
+
+std::vector<const MEGASignature*>
+MEGASignatureDB::FindSignatures(std::span<const std::span<const u32>> functions,
+                                size_t min_functions_per_thread) const
+{
+  std::vector<const MEGASignature*> matches(functions.size());
+  auto futures = Common::RunInParallel(
+      functions.size(), min_functions_per_thread, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+          if (const std::optional<u32> index = FindSignature(functions[i]))
+            matches[i] = &m_signatures[*index];
+        }
+      });
+  for (std::future<void>& future : futures)
+    future.get();
+  return matches;
+}
+
 void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
+  // Emulated memory can only be read from this thread, so read the code of every function that
+  // has the size of a signature first, and then compare it on all threads.
+  std::vector<Common::Symbol*> symbols;
+  std::vector<size_t> code_offsets;
+  std::vector<u32> code;
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (symbol.size % sizeof(u32) != 0 ||
+        !m_index.contains(static_cast<u32>(symbol.size / sizeof(u32))))
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
-      }
+      continue;
     }
+
+    symbols.push_back(&symbol);
+    code_offsets.push_back(code.size());
+    for (u32 offset = 0; offset < symbol.size; offset += sizeof(u32))
+      code.push_back(PowerPC::MMU::HostRead_U32(guard, symbol.address + offset));
+  }
+  code_offsets.push_back(code.size());
+
+  std::vector<std::span<const u32>> functions(symbols.size());
+  for (size_t i = 0; i < symbols.size(); ++i)
+  {
+    functions[i] =
+        std::span<const u32>(code).subspan(code_offsets[i], code_offsets[i + 1] - code_offsets[i]);
+  }
+
+  const std::vector<const MEGASignature*> matches = FindSignatures(functions);
+  for (size_t i = 0; i < symbols.size(); ++i)
+  {
+    if (!matches[i])
+      continue;
+
+    Common::Symbol& symbol = *symbols[i];
+    const MEGASignature& sig = *matches[i];
+    symbol.name = sig.name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
+                 symbol.size);
   }
   symbol_db->Index();
 }
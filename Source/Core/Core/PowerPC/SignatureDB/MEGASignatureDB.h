@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -43,6 +47,9 @@ struct MEGASignature
 class MEGASignatureDB : public SignatureDBFormatHandler
 {
 public:
+  // Below this many functions per thread, starting threads costs more than it saves.
+  static constexpr size_t MIN_FUNCTIONS_PER_THREAD = 256;
+
   MEGASignatureDB();
   ~MEGASignatureDB() override;
 
@@ -57,6 +64,27 @@ public:
   bool Add(const Core::CPUThreadGuard& guard, u32 startAddr, u32 size,
            const std::string& name) override;
 
+  // Returns the first signature, in file order, that matches the code of each function, or nullptr
+  // if none does. The functions are split over threads that get at least min_functions_per_thread
+  // functions each.
+  std::vector<const MEGASignature*>
+  FindSignatures(std::span<const std::span<const u32>> functions,
+                 size_t min_functions_per_thread = MIN_FUNCTIONS_PER_THREAD) const;
+
 private:
+  // The signatures of one size, keyed by their first instruction.
+  struct SizeIndex
+  {
+    std::unordered_map<u32, std::vector<u32>> by_first_instruction;
+    // Signatures that start with a wildcard.
+    std::vector<u32> wildcard_first_instruction;
+  };
+
+  void AddToIndex(u32 signature_index);
+  // Returns the first signature, in file order, that matches the given code.
+  std::optional<u32> FindSignature(std::span<const u32> code) const;
+
   std::vector<MEGASignature> m_signatures;
+  // Index of m_signatures keyed by size in instructions. The indices in it are sorted.
+  std::unordered_map<u32, SizeIndex> m_index;
 };
@@ -7,6 +7,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <locale>
 #include <map>
 #include <memory>
@@ -21,6 +23,7 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -28,6 +31,7 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelUtil.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
 #include "Common/Timer.h"
@@ -36,17 +40,20 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateDelta.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -75,13 +82,34 @@ static std::mutex s_undo_load_buffer_mutex;
 
 static std::mutex s_load_or_save_in_progress_mutex;
 
+// Number of states kept by the rewind buffer, and how much memory they may take up
+constexpr size_t REWIND_BUFFER_CAPACITY = 120;
+constexpr size_t REWIND_BUFFER_MAX_BYTES = 512 * 1024 * 1024;
+
+static StateRing s_rewind_buffer{REWIND_BUFFER_CAPACITY, REWIND_BUFFER_MAX_BYTES};
+static std::mutex s_rewind_buffer_mutex;
+// Fields emulated since the last periodic save to the rewind buffer (CPU thread only)
+static u64 s_fields_since_rewind_save = 0;
+
 struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
+  CompressionType compression_type;
+  int compression_level;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
+// The buffer of the last saved state, handed back by the worker thread once the state is on disk,
+// so that the next save can reuse its allocation. It is only kept while more saves are queued, so
+// that a buffer the size of a whole state isn't held on to between saves.
+static std::vector<u8> s_recycled_save_buffer;
+static std::mutex s_recycled_save_buffer_mutex;
+
+// The size of the last state that was saved. Saves start out with a buffer of about this size, so
+// that they don't need a separate pass to measure the state even when there's no buffer to reuse.
+static std::atomic<size_t> s_last_state_size = 0;
+
 // Protects against simultaneous reads and writes to the final savestate location from multiple
 // threads.
 static std::mutex s_save_thread_mutex;
@@ -106,6 +134,10 @@ constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
+// Zstd states are split into independently compressed chunks of this size, so that both
+// compression and decompression can be spread across threads.
+constexpr u64 ZSTD_CHUNK_SIZE = 4 * 1024 * 1024;
+
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
 // Maps savestate versions to Dolphin versions.
@@ -131,14 +163,34 @@ enum
   STATE_LOAD = 2,
 };
 
-static bool s_use_compression = true;
+static std::atomic<bool> s_use_compression = true;
 
 void EnableCompression(bool compression)
 {
   s_use_compression = compression;
 }
 
-static void DoState(Core::System& system, PointerWrap& p)
+static CompressionType GetCompressionType()
+{
+  if (!s_use_compression)
+    return CompressionType::Uncompressed;
+
+  const CompressionType type = Config::Get(Config::MAIN_SAVESTATE_COMPRESSION);
+  switch (type)
+  {
+  case CompressionType::Uncompressed:
+  case CompressionType::LZ4:
+  case CompressionType::Zstd:
+    return type;
+  default:
+    return CompressionType::LZ4;
+  }
+}
+
+// end_section, if set, is called at the end of each top-level section of the state. This lets the
+// rewind buffer delta-encode the sections separately.
+static void DoState(Core::System& system, PointerWrap& p,
+                    const std::function<void()>& end_section = {})
 {
   bool is_wii = system.IsWii() || system.IsMIOS();
   const bool is_wii_currently = is_wii;
@@ -175,29 +227,43 @@ static void DoState(Core::System& system, PointerWrap& p)
   // state load, and the frame number must be up-to-date.
   system.GetMovie().DoState(p);
   p.DoMarker("Movie");
+  if (end_section)
+    end_section();
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
   g_video_backend->DoState(p);
   p.DoMarker("video_backend");
+  if (end_section)
+    end_section();
 
   // CoreTiming needs to be restored before restoring Hardware because
   // the controller code might need to schedule an event if the controller has changed.
   system.GetCoreTiming().DoState(p);
   p.DoMarker("CoreTiming");
+  if (end_section)
+    end_section();
 
   // HW needs to be restored before PowerPC because the data cache might need to be flushed.
   HW::DoState(system, p);
   p.DoMarker("HW");
+  if (end_section)
+    end_section();
 
   system.GetPowerPC().DoState(p);
   p.DoMarker("PowerPC");
+  if (end_section)
+    end_section();
 
   if (system.IsWii())
     Wiimote::DoState(p);
   p.DoMarker("Wiimote");
+  if (end_section)
+    end_section();
   Gecko::DoState(p);
   p.DoMarker("Gecko");
+  if (end_section)
+    end_section();
 
 #ifdef USE_RETRO_ACHIEVEMENTS
   AchievementManager::GetInstance().DoState(p);
@@ -218,6 +284,11 @@ void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
     return;
   }
 
+  LoadFromBufferForRollback(system, buffer);
+}
+
+void LoadFromBufferForRollback(Core::System& system, std::vector<u8>& buffer)
+{
   Core::RunOnCPUThread(
       system,
       [&] {
@@ -228,23 +299,125 @@ void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
       true);
 }
 
+// Serializes the state into the given buffer, reusing its allocation. The size of the buffer, or
+// of the last saved state if that is larger, is used as a guess for the state size, which saves a
+// separate measuring pass. If sections is set, the start offsets of the top-level sections of the
+// state are stored in it.
+static bool DoStateToBuffer(Core::System& system, std::vector<u8>& buffer,
+                            StateSections* sections = nullptr)
+{
+  // The size of a state barely changes while the same game is running, but leave some room in
+  // case it grows.
+  const size_t size_hint = s_last_state_size.load(std::memory_order_relaxed);
+  if (buffer.size() < size_hint)
+    buffer.resize(size_hint + size_hint / 64);
+
+  for (int attempt = 0; attempt < 2; ++attempt)
+  {
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+    if (sections)
+    {
+      sections->assign(1, 0);
+      DoState(system, p, [&] { sections->push_back(static_cast<size_t>(ptr - buffer.data())); });
+    }
+    else
+    {
+      DoState(system, p);
+    }
+    const size_t state_size = static_cast<size_t>(ptr - buffer.data());
+
+    if (p.IsWriteMode())
+    {
+      buffer.resize(state_size);
+      s_last_state_size.store(state_size, std::memory_order_relaxed);
+      return true;
+    }
+
+    // If the buffer was too small, PointerWrap switched to measure mode and kept counting, so we
+    // know how large the buffer has to be. Otherwise, someone aborted the save.
+    if (state_size <= buffer.size())
+      return false;
+    buffer.resize(state_size);
+  }
+
+  return false;
+}
+
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
 {
   Core::RunOnCPUThread(
       system,
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+        if (!DoStateToBuffer(system, buffer))
+          buffer.clear();
+      },
+      true);
+}
 
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+void SaveToRewindBuffer(Core::System& system)
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(s_rewind_buffer_mutex);
+    buffer = s_rewind_buffer.TakeSpareBuffer();
+  }
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(system, p);
+  StateSections sections;
+  Core::RunOnCPUThread(
+      system,
+      [&] {
+        if (!DoStateToBuffer(system, buffer, &sections))
+          buffer.clear();
       },
       true);
+  if (buffer.empty())
+    return;
+
+  std::lock_guard lk(s_rewind_buffer_mutex);
+  s_rewind_buffer.Push(std::move(buffer), std::move(sections));
+}
+
+bool LoadFromRewindBuffer(Core::System& system, size_t states_back)
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(s_rewind_buffer_mutex);
+    if (!s_rewind_buffer.Get(states_back, buffer))
+    {
+      OSD::AddMessage("No rewind state available");
+      return false;
+    }
+    s_rewind_buffer.DropNewest(states_back + 1);
+  }
+
+  LoadFromBuffer(system, buffer);
+  return true;
+}
+
+void ClearRewindBuffer()
+{
+  std::lock_guard lk(s_rewind_buffer_mutex);
+  s_rewind_buffer.Clear();
+}
+
+void UpdateRewindBuffer(Core::System& system)
+{
+  const u32 interval = Config::Get(Config::MAIN_REWIND_INTERVAL);
+  if (interval == 0 || NetPlay::IsNetPlayRunning())
+  {
+    s_fields_since_rewind_save = 0;
+    return;
+  }
+
+  const double fields_per_second = system.GetVideoInterface().GetTargetRefreshRate();
+  if (++s_fields_since_rewind_save < static_cast<u64>(interval * fields_per_second))
+    return;
+
+  // This is called from inside a CoreTiming event, where the timing state is in the middle of
+  // being updated, so the save has to wait until the CPU thread is paused like for any other save.
+  s_fields_since_rewind_save = 0;
+  Core::QueueHostJob([](Core::System& host_system) { SaveToRewindBuffer(host_system); });
 }
 
 namespace
@@ -350,19 +523,61 @@ static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f
   }
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CompressBufferToFileZstd(const u8* raw_buffer, u64 size, int level, File::IOFile& f)
+{
+  const size_t chunk_count = static_cast<size_t>((size + ZSTD_CHUNK_SIZE - 1) / ZSTD_CHUNK_SIZE);
+  std::vector<std::vector<u8>> compressed_chunks(chunk_count);
+  auto compression_futures = Common::RunInParallel(
+      chunk_count, 1, [raw_buffer, size, level, &compressed_chunks](size_t start, size_t end) {
+        for (size_t j = start; j < end; ++j)
+        {
+          const u64 offset = j * ZSTD_CHUNK_SIZE;
+          const size_t chunk_size = static_cast<size_t>(std::min(ZSTD_CHUNK_SIZE, size - offset));
+
+          std::vector<u8>& compressed = compressed_chunks[j];
+          compressed.resize(ZSTD_compressBound(chunk_size));
+          const size_t compressed_len = ZSTD_compress(compressed.data(), compressed.size(),
+                                                      raw_buffer + offset, chunk_size, level);
+          if (ZSTD_isError(compressed_len))
+            return false;
+          compressed.resize(compressed_len);
+        }
+        return true;
+      });
+
+  bool success = true;
+  for (std::future<bool>& future : compression_futures)
+    success &= future.get();
+
+  if (!success)
+  {
+    PanicAlertFmtT("Internal Zstd Error - compression failed");
+    return;
+  }
+
+  for (const std::vector<u8>& compressed : compressed_chunks)
+  {
+    // The size of the data to write is 'compressed_len'
+    const u32 compressed_len = static_cast<u32>(compressed.size());
+    f.WriteArray(&compressed_len, 1);
+    f.WriteBytes(compressed.data(), compressed_len);
+  }
+}
+
+static void CreateExtendedHeader(StateExtendedHeader& extended_header,
+                                 CompressionType compression_type, size_t uncompressed_size)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = compression_type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(CompressionType compression_type, size_t uncompressed_size,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -374,7 +589,7 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, compression_type, uncompressed_size);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
@@ -408,12 +623,20 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(save_args.compression_type, buffer_size, f);
 
-  if (s_use_compression)
+  switch (save_args.compression_type)
+  {
+  case CompressionType::LZ4:
     CompressBufferToFile(buffer_data, buffer_size, f);
-  else
+    break;
+  case CompressionType::Zstd:
+    CompressBufferToFileZstd(buffer_data, buffer_size, save_args.compression_level, f);
+    break;
+  default:
     f.WriteBytes(buffer_data, buffer_size);
+    break;
+  }
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -484,20 +707,13 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
         std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
-        ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(system, p);
+        {
+          std::lock_guard lk_(s_recycled_save_buffer_mutex);
+          current_buffer.swap(s_recycled_save_buffer);
+        }
 
-        if (p.IsWriteMode())
+        if (DoStateToBuffer(system, current_buffer))
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -505,6 +721,8 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
 
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
+          save_args.compression_type = GetCompressionType();
+          save_args.compression_level = Config::Get(Config::MAIN_SAVESTATE_COMPRESSION_LEVEL);
           save_args.filename = filename;
           if (wait)
           {
@@ -723,6 +941,77 @@ static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f
   }
 }
 
+static bool DecompressZstd(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f)
+{
+  // Every chunk takes at least its u32 length in the file. Checking this before allocating
+  // anything keeps a corrupted uncompressed size from making us allocate absurd amounts of memory.
+  const u64 file_size = f.GetSize();
+  const u64 chunk_count_u64 = (size + ZSTD_CHUNK_SIZE - 1) / ZSTD_CHUNK_SIZE;
+  if (f.Tell() > file_size || chunk_count_u64 > (file_size - f.Tell()) / sizeof(u32))
+  {
+    PanicAlertFmt("State data size mismatch");
+    return false;
+  }
+
+  const size_t chunk_count = static_cast<size_t>(chunk_count_u64);
+  std::vector<std::vector<u8>> compressed_chunks(chunk_count);
+  for (size_t i = 0; i < chunk_count; ++i)
+  {
+    u32 compressed_data_len;
+    if (!f.ReadArray(&compressed_data_len, 1))
+    {
+      PanicAlertFmt("Could not read state data length");
+      return false;
+    }
+
+    const u64 chunk_size = std::min(ZSTD_CHUNK_SIZE, size - i * ZSTD_CHUNK_SIZE);
+    if (compressed_data_len > ZSTD_compressBound(static_cast<size_t>(chunk_size)) ||
+        compressed_data_len > file_size - f.Tell())
+    {
+      PanicAlertFmt("State data length is invalid");
+      return false;
+    }
+
+    std::vector<u8>& compressed = compressed_chunks[i];
+    compressed.resize(compressed_data_len);
+    if (!f.ReadBytes(compressed.data(), compressed_data_len))
+    {
+      PanicAlertFmt("Could not read state data");
+      return false;
+    }
+  }
+
+  raw_buffer.resize(size);
+
+  auto decompression_futures = Common::RunInParallel(
+      chunk_count, 1, [size, &raw_buffer, &compressed_chunks](size_t start, size_t end) {
+        for (size_t j = start; j < end; ++j)
+        {
+          const u64 offset = j * ZSTD_CHUNK_SIZE;
+          const size_t chunk_size = static_cast<size_t>(std::min(ZSTD_CHUNK_SIZE, size - offset));
+
+          const std::vector<u8>& compressed = compressed_chunks[j];
+          const size_t bytes_read = ZSTD_decompress(raw_buffer.data() + offset, chunk_size,
+                                                    compressed.data(), compressed.size());
+          if (ZSTD_isError(bytes_read) || bytes_read != chunk_size)
+            return false;
+        }
+        return true;
+      });
+
+  bool success = true;
+  for (std::future<bool>& future : decompression_futures)
+    success &= future.get();
+
+  if (!success)
+  {
+    PanicAlertFmtT("Internal Zstd Error - decompression failed");
+    return false;
+  }
+
+  return true;
+}
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -820,6 +1109,14 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     break;
   }
+  case CompressionType::Zstd:
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+    if (!DecompressZstd(buffer, extended_header.base_header.uncompressed_size, f))
+      return;
+
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -945,12 +1242,22 @@ void Init(Core::System& system)
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
     CompressAndDumpState(system, args);
 
+    bool queue_is_empty;
     {
       std::lock_guard lk(s_state_writes_in_queue_mutex);
-      if (--s_state_writes_in_queue == 0)
+      queue_is_empty = --s_state_writes_in_queue == 0;
+      if (queue_is_empty)
         s_state_write_queue_is_empty.notify_all();
     }
 
+    {
+      std::lock_guard lk(s_recycled_save_buffer_mutex);
+      if (queue_is_empty)
+        std::vector<u8>().swap(s_recycled_save_buffer);
+      else
+        s_recycled_save_buffer = std::move(args.buffer_vector);
+    }
+
     if (args.state_write_done_event)
       args.state_write_done_event->Set();
   });
@@ -967,6 +1274,14 @@ void Shutdown()
     std::lock_guard lk(s_undo_load_buffer_mutex);
     std::vector<u8>().swap(s_undo_load_buffer);
   }
+  {
+    std::lock_guard lk(s_recycled_save_buffer_mutex);
+    std::vector<u8>().swap(s_recycled_save_buffer);
+  }
+  s_last_state_size = 0;
+
+  ClearRewindBuffer();
+  s_fields_since_rewind_save = 0;
 }
 
 static std::string MakeStateFilename(int number)
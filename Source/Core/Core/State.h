@@ -55,6 +55,7 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  Zstd = 2,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -84,6 +85,8 @@ void Init(Core::System& system);
 
 void Shutdown();
 
+// If enabled (the default), states are compressed with the method set in
+// MAIN_SAVESTATE_COMPRESSION.
 void EnableCompression(bool compression);
 
 bool ReadHeader(const std::string& filename, StateHeader& header);
@@ -108,6 +111,21 @@ void LoadAs(Core::System& system, const std::string& filename);
 
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
+// Like LoadFromBuffer, but also allowed during NetPlay. For NetPlay's rollback mode, which loads
+// a state on every player that has to simulate some frames again.
+void LoadFromBufferForRollback(Core::System& system, std::vector<u8>& buffer);
+
+// In-memory rewind buffer. States are delta-encoded against periodic keyframes (see
+// StateDelta.h), so taking one every few seconds is cheap.
+void SaveToRewindBuffer(Core::System& system);
+// Loads the state saved the given number of saves ago (0 being the most recent one) and drops it
+// along with all states newer than it, so that rewinding again goes further back. Returns false
+// if there is no such state.
+bool LoadFromRewindBuffer(Core::System& system, size_t states_back = 0);
+void ClearRewindBuffer();
+// Queues a save to the rewind buffer every MAIN_REWIND_INTERVAL seconds. Called on the CPU thread
+// at each field boundary.
+void UpdateRewindBuffer(Core::System& system);
 
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
@@ -0,0 +1,316 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace State
+{
+namespace
+{
+struct DeltaHeader
+{
+  u64 state_size;
+  u64 base_size;
+};
+static_assert(std::is_trivially_copyable_v<DeltaHeader>);
+
+// Marks a run which isn't copied from the base, but followed by its contents.
+constexpr u64 NOT_IN_BASE = ~u64(0);
+
+struct DeltaRun
+{
+  u64 offset;
+  u64 size;
+  u64 base_offset;
+};
+static_assert(std::is_trivially_copyable_v<DeltaRun>);
+
+template <typename T>
+void Append(std::vector<u8>& out, const T& value)
+{
+  const size_t offset = out.size();
+  out.resize(offset + sizeof(T));
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+class DeltaWriter
+{
+public:
+  DeltaWriter(std::span<const u8> state, std::vector<u8>& out) : m_state(state), m_out(out) {}
+  ~DeltaWriter() { Flush(); }
+
+  DeltaWriter(const DeltaWriter&) = delete;
+  DeltaWriter& operator=(const DeltaWriter&) = delete;
+
+  // Adjacent runs that can be merged are merged.
+  void AddRun(u64 offset, u64 size, u64 base_offset)
+  {
+    const bool continues_run =
+        m_run.size != 0 && m_run.offset + m_run.size == offset &&
+        (base_offset == NOT_IN_BASE ? m_run.base_offset == NOT_IN_BASE :
+                                      m_run.base_offset + m_run.size == base_offset);
+    if (continues_run)
+    {
+      m_run.size += size;
+      return;
+    }
+
+    Flush();
+    m_run = {offset, size, base_offset};
+  }
+
+private:
+  void Flush()
+  {
+    if (m_run.size == 0)
+      return;
+
+    Append(m_out, m_run);
+    if (m_run.base_offset == NOT_IN_BASE)
+    {
+      m_out.insert(m_out.end(), m_state.begin() + m_run.offset,
+                   m_state.begin() + m_run.offset + m_run.size);
+    }
+    m_run = {};
+  }
+
+  std::span<const u8> m_state;
+  std::vector<u8>& m_out;
+  DeltaRun m_run{};
+};
+}  // namespace
+
+void CreateDelta(std::span<const u8> base, const StateSections& base_sections,
+                 std::span<const u8> state, const StateSections& state_sections,
+                 std::vector<u8>& delta)
+{
+  delta.clear();
+  Append(delta, DeltaHeader{state.size(), base.size()});
+
+  const bool use_sections = base_sections.size() == state_sections.size();
+  const size_t section_count = use_sections ? std::max<size_t>(state_sections.size(), 1) : 1;
+
+  DeltaWriter writer(state, delta);
+  for (size_t section = 0; section < section_count; ++section)
+  {
+    const auto get_range = [&](const StateSections& sections, size_t total_size) {
+      if (!use_sections || sections.empty())
+        return std::pair<size_t, size_t>(0, total_size);
+      const size_t begin = section == 0 ? 0 : sections[section];
+      const size_t end = section + 1 < sections.size() ? sections[section + 1] : total_size;
+      return std::pair<size_t, size_t>(std::min(begin, total_size), std::min(end, total_size));
+    };
+    const auto [state_begin, state_end] = get_range(state_sections, state.size());
+    const auto [base_begin, base_end] = get_range(base_sections, base.size());
+
+    for (size_t offset = 0; state_begin + offset < state_end; offset += DELTA_PAGE_SIZE)
+    {
+      const size_t size = std::min(DELTA_PAGE_SIZE, state_end - state_begin - offset);
+      const bool in_base =
+          base_begin + offset + size <= base_end &&
+          std::memcmp(base.data() + base_begin + offset, state.data() + state_begin + offset,
+                      size) == 0;
+      writer.AddRun(state_begin + offset, size, in_base ? base_begin + offset : NOT_IN_BASE);
+    }
+  }
+}
+
+std::vector<u8> CreateDelta(std::span<const u8> base, const StateSections& base_sections,
+                            std::span<const u8> state, const StateSections& state_sections)
+{
+  std::vector<u8> delta;
+  CreateDelta(base, base_sections, state, state_sections, delta);
+  return delta;
+}
+
+std::vector<u8> CreateDelta(std::span<const u8> base, std::span<const u8> state)
+{
+  return CreateDelta(base, {}, state, {});
+}
+
+bool ApplyDelta(std::span<const u8> base, std::span<const u8> delta, std::vector<u8>& state)
+{
+  DeltaHeader header;
+  if (delta.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, delta.data(), sizeof(header));
+  if (header.base_size != base.size())
+    return false;
+
+  state.resize(header.state_size);
+
+  size_t position = sizeof(header);
+  while (position < delta.size())
+  {
+    DeltaRun run;
+    if (delta.size() - position < sizeof(run))
+      return false;
+    std::memcpy(&run, delta.data() + position, sizeof(run));
+    position += sizeof(run);
+
+    if (run.offset > state.size() || run.size > state.size() - run.offset)
+      return false;
+
+    if (run.base_offset == NOT_IN_BASE)
+    {
+      if (delta.size() - position < run.size)
+        return false;
+      std::copy_n(delta.begin() + position, run.size, state.begin() + run.offset);
+      position += run.size;
+    }
+    else
+    {
+      if (run.base_offset > base.size() || run.size > base.size() - run.base_offset)
+        return false;
+      std::copy_n(base.begin() + run.base_offset, run.size, state.begin() + run.offset);
+    }
+  }
+
+  return true;
+}
+
+StateRing::StateRing(size_t capacity, size_t max_bytes)
+    : m_entries(std::max<size_t>(capacity, 1)), m_max_bytes(max_bytes)
+{
+}
+
+void StateRing::Push(std::vector<u8> state, StateSections sections)
+{
+  bool is_keyframe = !m_keyframe || m_force_keyframe;
+  if (!is_keyframe)
+  {
+    CreateDelta(m_keyframe->state, m_keyframe->sections, state, sections, m_delta_buffer);
+    is_keyframe = m_delta_buffer.size() > state.size() / 4;
+  }
+
+  // When the ring is full, this overwrites the oldest entry. Its delta buffer is reused.
+  Entry& entry = m_entries[m_next];
+  ReleaseKeyframe(entry);
+  if (is_keyframe)
+  {
+    m_keyframe = std::make_shared<Keyframe>(Keyframe{std::move(state), std::move(sections)});
+    entry.delta = {};
+  }
+  else
+  {
+    entry.delta.assign(m_delta_buffer.begin(), m_delta_buffer.end());
+    KeepSpareBuffer(std::move(state));
+  }
+  entry.keyframe = m_keyframe;
+
+  m_next = (m_next + 1) % m_entries.size();
+  m_size = std::min(m_size + 1, m_entries.size());
+
+  // Dropping only some states of a keyframe wouldn't free the keyframe, so whole keyframes are
+  // dropped along with their states.
+  while (GetMemoryUsage() > m_max_bytes && DropOldestGroup())
+  {
+  }
+  m_force_keyframe = GetMemoryUsage() > m_max_bytes;
+}
+
+std::vector<u8> StateRing::TakeSpareBuffer()
+{
+  return std::exchange(m_spare_buffer, {});
+}
+
+size_t StateRing::GetEntryIndex(size_t index) const
+{
+  return (m_next + m_entries.size() - 1 - index) % m_entries.size();
+}
+
+const StateRing::Entry& StateRing::GetEntry(size_t index) const
+{
+  return m_entries[GetEntryIndex(index)];
+}
+
+void StateRing::ReleaseKeyframe(Entry& entry)
+{
+  if (entry.keyframe && entry.keyframe.use_count() == 1)
+    KeepSpareBuffer(std::move(entry.keyframe->state));
+  entry.keyframe.reset();
+}
+
+void StateRing::KeepSpareBuffer(std::vector<u8> buffer)
+{
+  if (buffer.capacity() > m_spare_buffer.capacity())
+    m_spare_buffer = std::move(buffer);
+}
+
+bool StateRing::DropOldestGroup()
+{
+  if (m_size == 0)
+    return false;
+
+  const Keyframe* const oldest_keyframe = GetEntry(m_size - 1).keyframe.get();
+  if (oldest_keyframe == m_keyframe.get())
+    return false;
+
+  while (m_size != 0 && GetEntry(m_size - 1).keyframe.get() == oldest_keyframe)
+  {
+    Entry& entry = m_entries[GetEntryIndex(m_size - 1)];
+    ReleaseKeyframe(entry);
+    entry.delta = {};
+    --m_size;
+  }
+  return true;
+}
+
+bool StateRing::Get(size_t index, std::vector<u8>& state) const
+{
+  if (index >= m_size)
+    return false;
+
+  const Entry& entry = GetEntry(index);
+  if (entry.delta.empty())
+  {
+    state = entry.keyframe->state;
+    return true;
+  }
+
+  return ApplyDelta(entry.keyframe->state, entry.delta, state);
+}
+
+void StateRing::DropNewest(size_t count)
+{
+  count = std::min(count, m_size);
+  m_keyframe.reset();
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_next = (m_next + m_entries.size() - 1) % m_entries.size();
+    ReleaseKeyframe(m_entries[m_next]);
+    m_entries[m_next].delta = {};
+  }
+  m_size -= count;
+
+  m_keyframe = m_size != 0 ? GetEntry(0).keyframe : nullptr;
+  m_force_keyframe = false;
+}
+
+void StateRing::Clear()
+{
+  DropNewest(m_size);
+  m_delta_buffer = {};
+  m_spare_buffer = {};
+}
+
+size_t StateRing::GetMemoryUsage() const
+{
+  size_t usage = 0;
+  const Keyframe* previous_keyframe = nullptr;
+  for (size_t i = m_size; i-- > 0;)
+  {
+    const Entry& entry = GetEntry(i);
+    usage += entry.delta.capacity();
+    if (entry.keyframe.get() != previous_keyframe)
+      usage += entry.keyframe->state.capacity();
+    previous_keyframe = entry.keyframe.get();
+  }
+  return usage;
+}
+}  // namespace State
@@ -0,0 +1,110 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Page-granular delta encoding of savestate buffers.
+//
+// Most of a savestate is MEM1, MEM2 and ARAM, and only a small part of those changes between two
+// states taken a few seconds apart. Storing only the pages that differ from a reference state
+// makes frequent snapshots (rewind, autosave) cheap in both time and memory.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+constexpr size_t DELTA_PAGE_SIZE = 0x1000;
+
+// The offsets at which the sections of a state (see State::DoState) start, in increasing order.
+// Sections are compared separately, so that a section which grows or shrinks doesn't make all the
+// pages after it differ from the base. States with different numbers of sections are compared as
+// a whole.
+using StateSections = std::vector<size_t>;
+
+// Returns a delta which turns base into state when passed to ApplyDelta.
+std::vector<u8> CreateDelta(std::span<const u8> base, const StateSections& base_sections,
+                            std::span<const u8> state, const StateSections& state_sections);
+std::vector<u8> CreateDelta(std::span<const u8> base, std::span<const u8> state);
+// Like above, but writes the delta into the given buffer, reusing its allocation.
+void CreateDelta(std::span<const u8> base, const StateSections& base_sections,
+                 std::span<const u8> state, const StateSections& state_sections,
+                 std::vector<u8>& delta);
+
+// Reconstructs a state from the base it was created against. Returns false if the delta is
+// malformed or was created against a base of a different size.
+bool ApplyDelta(std::span<const u8> base, std::span<const u8> delta, std::vector<u8>& state);
+
+// Keeps the newest states, each stored as a delta against the last keyframe, or as a new keyframe
+// when too much of it has changed since then.
+class StateRing
+{
+public:
+  // Keeps at most capacity states, and drops the oldest ones once all states together take up
+  // more than max_bytes.
+  explicit StateRing(size_t capacity, size_t max_bytes = std::numeric_limits<size_t>::max());
+
+  // The buffer of the state is kept if the state becomes a keyframe, and is otherwise kept for
+  // TakeSpareBuffer.
+  void Push(std::vector<u8> state, StateSections sections = {});
+
+  // Returns a buffer of a state that is no longer needed, which the next state can be saved into
+  // without allocating a new one. Empty if there is none.
+  std::vector<u8> TakeSpareBuffer();
+
+  // Index 0 is the newest state.
+  bool Get(size_t index, std::vector<u8>& state) const;
+
+  // Drops the given number of newest states.
+  void DropNewest(size_t count);
+  // Drops all states, and frees the buffers that are kept for reuse.
+  void Clear();
+
+  size_t Size() const { return m_size; }
+  size_t Capacity() const { return m_entries.size(); }
+
+  // Approximate number of bytes held by the states, counting each keyframe once. The buffers that
+  // are kept for reuse aren't counted.
+  size_t GetMemoryUsage() const;
+
+private:
+  struct Keyframe
+  {
+    std::vector<u8> state;
+    StateSections sections;
+  };
+
+  struct Entry
+  {
+    std::shared_ptr<Keyframe> keyframe;
+    std::vector<u8> delta;  // Empty if this entry is the keyframe itself
+  };
+
+  size_t GetEntryIndex(size_t index) const;
+  const Entry& GetEntry(size_t index) const;
+
+  // Drops the keyframe of the entry, keeping its buffer as the spare buffer if nothing else uses it.
+  void ReleaseKeyframe(Entry& entry);
+  void KeepSpareBuffer(std::vector<u8> buffer);
+
+  // Drops all the states that use the oldest keyframe, unless it is the newest one.
+  bool DropOldestGroup();
+
+  std::vector<Entry> m_entries;
+  size_t m_next = 0;
+  size_t m_size = 0;
+  size_t m_max_bytes;
+  std::shared_ptr<Keyframe> m_keyframe;
+  // Set when the states of the newest keyframe take up too much memory on their own, so that
+  // they can be dropped once the next state has started a new keyframe.
+  bool m_force_keyframe = false;
+
+  std::vector<u8> m_delta_buffer;
+  std::vector<u8> m_spare_buffer;
+};
+}  // namespace State
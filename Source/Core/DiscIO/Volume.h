@@ -120,6 +120,9 @@ public:
   virtual bool IsDatelDisc() const = 0;
   virtual bool IsNKit() const = 0;
   virtual bool CheckH3TableIntegrity(const Partition& partition) const { return false; }
+  // Computes the data that CheckBlockIntegrity needs ahead of time, which makes it safe to call
+  // CheckBlockIntegrity for blocks of the partition from several threads at once.
+  virtual void PrepareBlockIntegrityChecks(const Partition& partition) const {}
   virtual bool CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
                                    const Partition& partition) const
   {
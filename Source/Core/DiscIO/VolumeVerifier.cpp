@@ -29,6 +29,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MinizipUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
@@ -415,6 +416,8 @@ void VolumeVerifier::Start()
   CheckMisc();
 
   SetUpHashing();
+
+  m_timer.Start();
 }
 
 std::vector<Partition> VolumeVerifier::CheckPartitions()
@@ -604,6 +607,9 @@ bool VolumeVerifier::CheckPartition(const Partition& partition)
   // Prepare for hash verification in the Process step
   if (m_volume.HasWiiHashes())
   {
+    // The blocks of a group are checked on several threads
+    m_volume.PrepareBlockIntegrityChecks(partition);
+
     const u64 data_size =
         m_volume.ReadSwappedAndShifted(partition.offset + 0x2bc, PARTITION_NONE).value_or(0);
     const size_t blocks = static_cast<size_t>(data_size / VolumeWii::BLOCK_TOTAL_SIZE);
@@ -1090,8 +1096,11 @@ void VolumeVerifier::WaitForAsyncOperations() const
     m_sha1_future.wait();
   if (m_content_future.valid())
     m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  for (const std::future<void>& future : m_group_futures)
+  {
+    if (future.valid())
+      future.wait();
+  }
 }
 
 bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
@@ -1240,36 +1249,43 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
+    const GroupToVerify& group = m_groups[m_group_index];
+    const size_t blocks = group.block_index_end - group.block_index_start;
+    m_group_futures = Common::RunInParallel(
+        blocks, 1, [this, read_failed, &group](size_t start, size_t end) {
+          u64 biggest_verified_offset = 0;
+          size_t block_errors = 0;
+          size_t unused_block_errors = 0;
+
+          for (size_t j = start; j < end; ++j)
           {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
+            const u64 offset_in_group = j * VolumeWii::BLOCK_TOTAL_SIZE;
+            const u64 block_offset = group.offset + offset_in_group;
+
+            if (!read_failed &&
+                m_volume.CheckBlockIntegrity(group.block_index_start + j,
+                                             m_data.data() + offset_in_group, group.partition))
+            {
+              biggest_verified_offset = block_offset + VolumeWii::BLOCK_TOTAL_SIZE;
+            }
+            else if (m_scrubber.CanBlockBeScrubbed(block_offset))
+            {
+              WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}",
+                           block_offset);
+              unused_block_errors++;
+            }
+            else
+            {
+              WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+              block_errors++;
+            }
           }
-        }
-      }
-    });
+
+          std::lock_guard lk(m_group_mutex);
+          m_biggest_verified_offset = std::max(m_biggest_verified_offset, biggest_verified_offset);
+          m_unused_block_errors[group.partition] += unused_block_errors;
+          m_block_errors[group.partition] += block_errors;
+        });
 
     m_group_index++;
   }
@@ -1295,6 +1311,10 @@ void VolumeVerifier::Finish()
 
   WaitForAsyncOperations();
 
+  m_timer.Stop();
+  const u64 elapsed_ms = std::max<u64>(m_timer.ElapsedMs(), 1);
+  m_result.throughput = static_cast<double>(m_progress) / 0x100000 * 1000 / elapsed_ms;
+
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
@@ -6,6 +6,7 @@
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -14,6 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/Timer.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -122,6 +124,7 @@ public:
     std::string summary_text;
     std::vector<Problem> problems;
     RedumpVerifier::Result redump;
+    double throughput = 0.0;  // In MiB/s, measured from Start() to Finish()
   };
 
   VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate);
@@ -184,7 +187,8 @@ private:
   std::future<void> m_md5_future;
   std::future<void> m_sha1_future;
   std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  std::vector<std::future<void>> m_group_futures;
+  std::mutex m_group_mutex;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -198,6 +202,7 @@ private:
   u64 m_biggest_referenced_offset = 0;
   u64 m_biggest_verified_offset = 0;
 
+  Common::Timer m_timer;
   bool m_started = false;
   bool m_done = false;
   u64 m_progress = 0;
@@ -434,6 +434,20 @@ bool VolumeWii::CheckH3TableIntegrity(const Partition& partition) const
   return Common::SHA1::CalculateDigest(h3_table) == contents[0].sha1;
 }
 
+void VolumeWii::PrepareBlockIntegrityChecks(const Partition& partition) const
+{
+  auto it = m_partitions.find(partition);
+  if (it == m_partitions.end())
+    return;
+  const PartitionDetails& partition_details = it->second;
+
+  // Lazy values aren't thread-safe, so they must not be computed for the first time by
+  // CheckBlockIntegrity
+  *partition_details.h3_table;
+  if (m_has_encryption)
+    *partition_details.key;
+}
+
 bool VolumeWii::CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
                                     const Partition& partition) const
 {
@@ -80,6 +80,7 @@ public:
   Platform GetVolumeType() const override;
   bool IsDatelDisc() const override;
   bool CheckH3TableIntegrity(const Partition& partition) const override;
+  void PrepareBlockIntegrityChecks(const Partition& partition) const override;
   bool CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
                            const Partition& partition) const override;
   bool CheckBlockIntegrity(u64 block_index, const Partition& partition) const override;
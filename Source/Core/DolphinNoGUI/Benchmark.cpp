@@ -0,0 +1,339 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/Benchmark.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/Hash.h"
+#include "Common/JsonUtil.h"
+#include "Common/Version.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "VideoCommon/PerformanceMetrics.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace
+{
+// In the order of Benchmark::GetVideoStageTimes.
+constexpr std::array<const char*, 4> VIDEO_STAGE_NAMES = {
+    "opcode_decoding_ms",
+    "vertex_loading_ms",
+    "texture_cache_ms",
+    "draw_submission_ms",
+};
+
+// CPU time used by the calling thread, which unlike wall time does not include time spent waiting
+// on the other emulation threads.
+std::chrono::nanoseconds GetThreadCPUTime()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+    return {};
+  const auto to_u64 = [](const FILETIME& time) {
+    return (u64(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  // FILETIME counts 100 ns intervals.
+  return std::chrono::nanoseconds((to_u64(kernel_time) + to_u64(user_time)) * 100);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return {};
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+int GetShadersCompiled()
+{
+  return g_stats.num_pixel_shaders_created + g_stats.num_vertex_shaders_created;
+}
+
+double ToMilliseconds(std::chrono::nanoseconds time)
+{
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+}  // namespace
+
+Benchmark::Benchmark(Options options, std::function<void()> on_finished)
+    : m_options(std::move(options)), m_on_finished(std::move(on_finished))
+{
+  m_end_field_hook = VIEndFieldEvent::Register([this] { OnEndField(); }, "Benchmark");
+  m_frame_hook = AfterFrameEvent::Register([this](Core::System&) { OnFrame(); }, "Benchmark");
+  if (m_options.hash_xfb)
+  {
+    m_present_hook = BeforePresentEvent::Register(
+        [this](const PresentInfo& present_info) { OnPresent(present_info); }, "Benchmark");
+  }
+  g_stage_timings.enabled.store(m_options.video_stage_timings, std::memory_order_relaxed);
+}
+
+Benchmark::~Benchmark()
+{
+  g_stage_timings.enabled.store(false, std::memory_order_relaxed);
+}
+
+void Benchmark::ApplyConfig(const Options& options)
+{
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  // Keep running once the movie ends, so that OnEndField can notice it.
+  Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+  // Stop at the end of FIFO logs.
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, false);
+
+  if (options.hash_xfb)
+  {
+    // The XFB must be in RAM, and up to date, by the time it is presented.
+    Config::SetCurrent(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM, false);
+    Config::SetCurrent(Config::GFX_HACK_DEFER_EFB_COPIES, false);
+  }
+}
+
+std::array<u64, 4> Benchmark::GetVideoStageTimes()
+{
+  return {
+      g_stage_timings.opcode_decoding.load(std::memory_order_relaxed),
+      g_stage_timings.vertex_loading.load(std::memory_order_relaxed),
+      g_stage_timings.texture_cache.load(std::memory_order_relaxed),
+      g_stage_timings.draw_submission.load(std::memory_order_relaxed),
+  };
+}
+
+void Benchmark::OnEndField()
+{
+  if (m_finished)
+    return;
+
+  auto& system = Core::System::GetInstance();
+  const std::chrono::nanoseconds cpu_thread_time = GetThreadCPUTime();
+  const std::chrono::nanoseconds jit_compile_time = system.GetJitInterface().GetCompileTime();
+  const int shaders_compiled = GetShadersCompiled();
+  const std::array<u64, 4> video_stage_times = GetVideoStageTimes();
+  const JitInterface::FastmemStats fastmem_stats = system.GetJitInterface().GetFastmemStats();
+  const PowerPC::MMU::TLBStats tlb_stats = system.GetMMU().GetTLBStats();
+  const bool movie_playing = system.GetMovie().IsPlayingInput();
+
+  if (!m_started)
+  {
+    // The first field only marks the start of the run.
+    m_started = true;
+    m_last_cpu_thread_time = cpu_thread_time;
+    m_last_jit_compile_time = jit_compile_time;
+    m_last_shaders_compiled = shaders_compiled;
+    m_last_video_stage_times = video_stage_times;
+    m_first_fastmem_stats = fastmem_stats;
+    m_first_tlb_stats = tlb_stats;
+    m_movie_was_playing = movie_playing;
+    m_gpu_thread_time.store(0, std::memory_order_relaxed);
+
+    std::lock_guard lk(m_frames_lock);
+    m_recording = true;
+    m_game_id = SConfig::GetInstance().GetGameID();
+    m_cpu_core = system.GetPowerPC().GetCPUName();
+    m_video_backend = g_video_backend->GetName();
+    m_dual_core = system.IsDualCoreMode();
+    m_start_time = std::chrono::steady_clock::now();
+    return;
+  }
+
+  Frame frame;
+  frame.cpu_thread_time = cpu_thread_time - m_last_cpu_thread_time;
+  frame.gpu_thread_time =
+      std::chrono::nanoseconds(m_gpu_thread_time.exchange(0, std::memory_order_relaxed));
+  frame.jit_compile_time = jit_compile_time - m_last_jit_compile_time;
+  // The counters are reset when the shader cache is reloaded.
+  frame.shaders_compiled = shaders_compiled >= m_last_shaders_compiled ?
+                               shaders_compiled - m_last_shaders_compiled :
+                               shaders_compiled;
+  frame.fps = g_perf_metrics.GetFPS();
+  frame.vps = g_perf_metrics.GetVPS();
+  for (size_t i = 0; i < video_stage_times.size(); ++i)
+    frame.video_stage_times[i] = video_stage_times[i] - m_last_video_stage_times[i];
+
+  m_last_cpu_thread_time = cpu_thread_time;
+  m_last_jit_compile_time = jit_compile_time;
+  m_last_shaders_compiled = shaders_compiled;
+  m_last_video_stage_times = video_stage_times;
+
+  bool finished = m_movie_was_playing && !movie_playing;
+  m_movie_was_playing = movie_playing;
+  {
+    std::lock_guard lk(m_frames_lock);
+    m_frames.push_back(frame);
+    m_fastmem_stats = {
+        fastmem_stats.logical_memory_updates - m_first_fastmem_stats.logical_memory_updates,
+        fastmem_stats.logical_pages_mapped - m_first_fastmem_stats.logical_pages_mapped,
+        fastmem_stats.logical_pages_unmapped - m_first_fastmem_stats.logical_pages_unmapped,
+        fastmem_stats.faults - m_first_fastmem_stats.faults,
+    };
+    m_tlb_stats = {
+        tlb_stats.shadow_hits - m_first_tlb_stats.shadow_hits,
+        tlb_stats.tlb_hits - m_first_tlb_stats.tlb_hits,
+        tlb_stats.page_table_walks - m_first_tlb_stats.page_table_walks,
+        tlb_stats.page_faults - m_first_tlb_stats.page_faults,
+    };
+    finished |= m_options.frame_limit != 0 && m_frames.size() >= m_options.frame_limit;
+    if (finished)
+    {
+      m_end_time = std::chrono::steady_clock::now();
+      m_recording = false;
+    }
+  }
+
+  if (finished)
+  {
+    m_finished = true;
+    m_on_finished();
+  }
+}
+
+void Benchmark::OnFrame()
+{
+  // In single core mode, GPU work is already part of the CPU thread time.
+  if (Core::IsCPUThread())
+    return;
+
+  const std::chrono::nanoseconds gpu_thread_time = GetThreadCPUTime();
+  if (m_gpu_started)
+  {
+    m_gpu_thread_time.fetch_add((gpu_thread_time - m_last_gpu_thread_time).count(),
+                                std::memory_order_relaxed);
+  }
+  m_gpu_started = true;
+  m_last_gpu_thread_time = gpu_thread_time;
+}
+
+void Benchmark::OnPresent(const PresentInfo& present_info)
+{
+  if (present_info.reason == PresentInfo::PresentReason::VideoInterfaceDuplicate)
+    return;
+
+  const u32 size = present_info.xfb_stride * present_info.xfb_height;
+  const u8* const xfb = Core::System::GetInstance().GetMemory().GetPointerForRange(
+      present_info.xfb_address, size);
+  const u64 hash = xfb ? Common::GetHash64(xfb, size, 0) : 0;
+
+  std::lock_guard lk(m_frames_lock);
+  if (m_recording)
+    m_presented_frames.push_back({present_info.frame_count, hash});
+}
+
+bool Benchmark::WriteReport() const
+{
+  std::lock_guard lk(m_frames_lock);
+
+  picojson::array cpu_thread_ms, gpu_thread_ms, jit_compile_ms, shaders_compiled, fps, vps;
+  std::chrono::nanoseconds total_cpu_thread_time{}, total_gpu_thread_time{};
+  std::chrono::nanoseconds total_jit_compile_time{};
+  double total_shaders_compiled = 0;
+  std::array<picojson::array, VIDEO_STAGE_NAMES.size()> video_stage_ms;
+  std::array<u64, VIDEO_STAGE_NAMES.size()> total_video_stage_times{};
+  for (const Frame& frame : m_frames)
+  {
+    cpu_thread_ms.emplace_back(ToMilliseconds(frame.cpu_thread_time));
+    gpu_thread_ms.emplace_back(ToMilliseconds(frame.gpu_thread_time));
+    jit_compile_ms.emplace_back(ToMilliseconds(frame.jit_compile_time));
+    shaders_compiled.emplace_back(static_cast<double>(frame.shaders_compiled));
+    fps.emplace_back(frame.fps);
+    vps.emplace_back(frame.vps);
+
+    total_cpu_thread_time += frame.cpu_thread_time;
+    total_gpu_thread_time += frame.gpu_thread_time;
+    total_jit_compile_time += frame.jit_compile_time;
+    total_shaders_compiled += frame.shaders_compiled;
+
+    for (size_t i = 0; i < VIDEO_STAGE_NAMES.size(); ++i)
+    {
+      video_stage_ms[i].emplace_back(
+          ToMilliseconds(std::chrono::nanoseconds(frame.video_stage_times[i])));
+      total_video_stage_times[i] += frame.video_stage_times[i];
+    }
+  }
+
+  // If emulation was stopped before the run finished, the report ends at the last field.
+  const auto end_time = m_end_time != std::chrono::steady_clock::time_point{} ?
+                            m_end_time :
+                            std::chrono::steady_clock::now();
+  const double wall_time =
+      m_frames.empty() ? 0.0 : std::chrono::duration<double>(end_time - m_start_time).count();
+
+  picojson::object totals;
+  totals.emplace("wall_time_s", wall_time);
+  totals.emplace("cpu_thread_ms", ToMilliseconds(total_cpu_thread_time));
+  totals.emplace("gpu_thread_ms", ToMilliseconds(total_gpu_thread_time));
+  totals.emplace("jit_compile_ms", ToMilliseconds(total_jit_compile_time));
+  totals.emplace("shaders_compiled", total_shaders_compiled);
+  totals.emplace("average_vps", wall_time > 0.0 ? m_frames.size() / wall_time : 0.0);
+  totals.emplace("fastmem_faults", static_cast<double>(m_fastmem_stats.faults));
+  totals.emplace("logical_memory_updates",
+                 static_cast<double>(m_fastmem_stats.logical_memory_updates));
+  totals.emplace("logical_pages_mapped", static_cast<double>(m_fastmem_stats.logical_pages_mapped));
+  totals.emplace("logical_pages_unmapped",
+                 static_cast<double>(m_fastmem_stats.logical_pages_unmapped));
+  totals.emplace("tlb_shadow_hits", static_cast<double>(m_tlb_stats.shadow_hits));
+  totals.emplace("tlb_hits", static_cast<double>(m_tlb_stats.tlb_hits));
+  totals.emplace("page_table_walks", static_cast<double>(m_tlb_stats.page_table_walks));
+  totals.emplace("page_faults", static_cast<double>(m_tlb_stats.page_faults));
+
+  picojson::object per_frame;
+  per_frame.emplace("cpu_thread_ms", std::move(cpu_thread_ms));
+  per_frame.emplace("gpu_thread_ms", std::move(gpu_thread_ms));
+  per_frame.emplace("jit_compile_ms", std::move(jit_compile_ms));
+  per_frame.emplace("shaders_compiled", std::move(shaders_compiled));
+  per_frame.emplace("fps", std::move(fps));
+  per_frame.emplace("vps", std::move(vps));
+
+  if (m_options.video_stage_timings)
+  {
+    for (size_t i = 0; i < VIDEO_STAGE_NAMES.size(); ++i)
+    {
+      totals.emplace(VIDEO_STAGE_NAMES[i],
+                     ToMilliseconds(std::chrono::nanoseconds(total_video_stage_times[i])));
+      per_frame.emplace(VIDEO_STAGE_NAMES[i], std::move(video_stage_ms[i]));
+    }
+  }
+
+  picojson::object root;
+  root.emplace("revision", Common::GetScmRevStr());
+  root.emplace("game_id", m_game_id);
+  root.emplace("cpu_core", m_cpu_core);
+  root.emplace("video_backend", m_video_backend);
+  root.emplace("dual_core", m_dual_core);
+  root.emplace("frames", static_cast<double>(m_frames.size()));
+  root.emplace("totals", std::move(totals));
+  root.emplace("per_frame", std::move(per_frame));
+
+  if (m_options.hash_xfb)
+  {
+    // Hashes are written as strings, as JSON numbers cannot hold all 64 bits.
+    picojson::array presented_frames;
+    for (const PresentedFrame& presented : m_presented_frames)
+    {
+      picojson::object entry;
+      entry.emplace("frame", static_cast<double>(presented.frame_count));
+      entry.emplace("xfb_hash", fmt::format("{:016x}", presented.xfb_hash));
+      presented_frames.emplace_back(std::move(entry));
+    }
+    root.emplace("presented_frames", std::move(presented_frames));
+  }
+
+  return JsonToFile(m_options.output_path, picojson::value(std::move(root)), true);
+}
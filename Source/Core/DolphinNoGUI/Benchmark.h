@@ -0,0 +1,114 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+
+struct PresentInfo;
+
+// Records how long every emulated field took to run and writes the results to a JSON file.
+//
+// A field is counted each time the VI finishes one, so a run of the same game or FIFO log with the
+// same movie always records the same fields, whatever the host speed is.
+class Benchmark
+{
+public:
+  struct Options
+  {
+    std::string output_path;
+    // A frame_limit of 0 records until emulation stops.
+    u32 frame_limit = 0;
+    // Hash the XFB of every presented frame. This makes XFB copies go to RAM.
+    bool hash_xfb = false;
+    // Measure the host time spent in each stage of the video pipeline.
+    bool video_stage_timings = false;
+  };
+
+  // on_finished is called on the CPU thread once frame_limit fields have been recorded, or when
+  // the movie being played ends.
+  Benchmark(Options options, std::function<void()> on_finished);
+  ~Benchmark();
+
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+  Benchmark(Benchmark&&) = delete;
+  Benchmark& operator=(Benchmark&&) = delete;
+
+  // Unthrottles emulation for the rest of the run, and applies the settings the options need.
+  static void ApplyConfig(const Options& options);
+
+  bool WriteReport() const;
+
+private:
+  struct Frame
+  {
+    std::chrono::nanoseconds cpu_thread_time;
+    std::chrono::nanoseconds gpu_thread_time;
+    std::chrono::nanoseconds jit_compile_time;
+    int shaders_compiled;
+    double fps;
+    double vps;
+    std::array<u64, 4> video_stage_times;
+  };
+
+  struct PresentedFrame
+  {
+    u64 frame_count;
+    u64 xfb_hash;
+  };
+
+  void OnEndField();
+  void OnFrame();
+  void OnPresent(const PresentInfo& present_info);
+
+  static std::array<u64, 4> GetVideoStageTimes();
+
+  Options m_options;
+  std::function<void()> m_on_finished;
+  bool m_finished = false;
+
+  // Accessed from the CPU thread only.
+  std::chrono::nanoseconds m_last_cpu_thread_time{};
+  std::chrono::nanoseconds m_last_jit_compile_time{};
+  int m_last_shaders_compiled = 0;
+  std::array<u64, 4> m_last_video_stage_times{};
+  JitInterface::FastmemStats m_first_fastmem_stats{};
+  PowerPC::MMU::TLBStats m_first_tlb_stats{};
+  bool m_movie_was_playing = false;
+  bool m_started = false;
+
+  // Accessed from the GPU thread only, and handed to the CPU thread through m_gpu_thread_time.
+  std::chrono::nanoseconds m_last_gpu_thread_time{};
+  bool m_gpu_started = false;
+  std::atomic<s64> m_gpu_thread_time{0};
+
+  mutable std::mutex m_frames_lock;
+  bool m_recording = false;
+  std::vector<Frame> m_frames;
+  std::vector<PresentedFrame> m_presented_frames;
+  // Counted since the start of the run.
+  JitInterface::FastmemStats m_fastmem_stats{};
+  PowerPC::MMU::TLBStats m_tlb_stats{};
+  std::string m_game_id;
+  std::string m_cpu_core;
+  std::string m_video_backend;
+  bool m_dual_core = false;
+  std::chrono::steady_clock::time_point m_start_time;
+  std::chrono::steady_clock::time_point m_end_time;
+
+  Common::EventHook m_end_field_hook;
+  Common::EventHook m_frame_hook;
+  Common::EventHook m_present_hook;
+};
@@ -7,6 +7,9 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <vector>
@@ -23,8 +26,11 @@
 #include "Core/BootManager.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/System.h"
+#include "DolphinNoGUI/Benchmark.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -52,6 +58,13 @@ static void signal_handler(int)
   s_platform->RequestShutdown();
 }
 
+#ifndef _WIN32
+static void profile_signal_handler(int)
+{
+  s_platform->RequestProfileWrite();
+}
+#endif
+
 std::vector<std::string> Host_GetPreferredLocales()
 {
   return {};
@@ -216,6 +229,32 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--benchmark")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Run unthrottled and write per-frame performance statistics to a JSON file");
+  parser->add_option("--benchmark_frames")
+      .action("store")
+      .metavar("<count>")
+      .type("int")
+      .help("Stop the benchmark after this many frames (default: until the movie or game ends)");
+  parser->add_option("--benchmark_xfb_hashes")
+      .action("store_true")
+      .help("Add a hash of every presented XFB to the benchmark report");
+  parser->add_option("--benchmark_video_stages")
+      .action("store_true")
+      .help("Add the time spent in each stage of the video pipeline to the benchmark report");
+  parser->add_option("--fifo_first_frame")
+      .action("store")
+      .metavar("<frame>")
+      .type("int")
+      .help("First frame of a FIFO log to play");
+  parser->add_option("--fifo_last_frame")
+      .action("store")
+      .metavar("<frame>")
+      .type("int")
+      .help("Last frame of a FIFO log to play");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -290,6 +329,70 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (options.is_set("movie"))
+  {
+    const std::string movie_path = static_cast<const char*>(options.get("movie"));
+    std::optional<std::string> movie_save_state_path;
+    if (!Core::System::GetInstance().GetMovie().PlayInput(movie_path, &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+    if (movie_save_state_path)
+    {
+      boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                               DeleteSavestateAfterBoot::No);
+    }
+  }
+
+  if (options.is_set("fifo_first_frame") || options.is_set("fifo_last_frame"))
+  {
+    const int first_frame = options.is_set("fifo_first_frame") ?
+                                static_cast<int>(options.get("fifo_first_frame")) :
+                                0;
+    const int last_frame = options.is_set("fifo_last_frame") ?
+                               static_cast<int>(options.get("fifo_last_frame")) :
+                               std::numeric_limits<int>::max();
+    if (first_frame < 0 || last_frame < first_frame)
+    {
+      fprintf(stderr, "Invalid FIFO log frame range\n");
+      return 1;
+    }
+
+    // Called when the FIFO log is opened during boot, before any frame is played.
+    auto& fifo_player = Core::System::GetInstance().GetFifoPlayer();
+    fifo_player.SetFileLoadedCallback([&fifo_player, first_frame, last_frame] {
+      if (!fifo_player.GetFile())
+        return;
+      fifo_player.SetFrameRangeEnd(static_cast<u32>(last_frame));
+      fifo_player.SetFrameRangeStart(static_cast<u32>(first_frame));
+    });
+  }
+
+  std::unique_ptr<Benchmark> benchmark;
+  if (options.is_set("benchmark"))
+  {
+    const int frame_limit = options.is_set("benchmark_frames") ?
+                                static_cast<int>(options.get("benchmark_frames")) :
+                                0;
+    if (frame_limit < 0)
+    {
+      fprintf(stderr, "Invalid benchmark frame count\n");
+      return 1;
+    }
+
+    Benchmark::Options benchmark_options;
+    benchmark_options.output_path = static_cast<const char*>(options.get("benchmark"));
+    benchmark_options.frame_limit = static_cast<u32>(frame_limit);
+    benchmark_options.hash_xfb = static_cast<bool>(options.get("benchmark_xfb_hashes"));
+    benchmark_options.video_stage_timings =
+        static_cast<bool>(options.get("benchmark_video_stages"));
+
+    Benchmark::ApplyConfig(benchmark_options);
+    benchmark = std::make_unique<Benchmark>(std::move(benchmark_options),
+                                            [] { s_platform->Stop(); });
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -306,6 +409,13 @@ int main(int argc, char* argv[])
   sa.sa_flags = SA_RESETHAND;
   sigaction(SIGINT, &sa, nullptr);
   sigaction(SIGTERM, &sa, nullptr);
+
+  // Write a snapshot of the JIT profile on SIGUSR1
+  struct sigaction profile_sa;
+  profile_sa.sa_handler = profile_signal_handler;
+  sigemptyset(&profile_sa.sa_mask);
+  profile_sa.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &profile_sa, nullptr);
 #endif
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
@@ -326,6 +436,12 @@ int main(int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (benchmark && !benchmark->WriteReport())
+  {
+    fprintf(stderr, "Could not write the benchmark report\n");
+    return 1;
+  }
+
   return 0;
 }
 
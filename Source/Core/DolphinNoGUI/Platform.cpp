@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "DolphinNoGUI/Platform.h"
+#include "Core/Core.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/State.h"
 #include "Core/System.h"
 
@@ -21,6 +23,12 @@ void Platform::SetTitle(const std::string& title)
 
 void Platform::UpdateRunningFlag()
 {
+  if (m_profile_write_requested.TestAndClear())
+  {
+    auto& system = Core::System::GetInstance();
+    system.GetJitInterface().WriteConfiguredJitProfile(Core::CPUThreadGuard{system});
+  }
+
   if (m_shutdown_requested.TestAndClear())
   {
     auto& system = Core::System::GetInstance();
@@ -48,3 +56,8 @@ void Platform::RequestShutdown()
 {
   m_shutdown_requested.Set();
 }
+
+void Platform::RequestProfileWrite()
+{
+  m_profile_write_requested.Set();
+}
@@ -30,6 +30,9 @@ public:
   // Request an immediate shutdown.
   void Stop();
 
+  // Requests that the JIT profile be written without stopping, from SIGUSR1.
+  void RequestProfileWrite();
+
   static std::unique_ptr<Platform> CreateHeadlessPlatform();
 #ifdef HAVE_X11
   static std::unique_ptr<Platform> CreateX11Platform();
@@ -53,6 +56,7 @@ protected:
   Common::Flag m_running{true};
   Common::Flag m_shutdown_requested{false};
   Common::Flag m_tried_graceful_shutdown{false};
+  Common::Flag m_profile_write_requested{false};
 
   bool m_window_focus = true;  // Should be made atomic if actually implemented
   bool m_window_fullscreen = false;
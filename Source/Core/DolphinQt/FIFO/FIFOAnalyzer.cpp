@@ -349,7 +349,9 @@ void FIFOAnalyzer::UpdateDetails()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
   const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const auto& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const std::shared_ptr<const FifoFrameInfo> fifo_frame_ptr =
+      m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -432,7 +434,9 @@ void FIFOAnalyzer::BeginSearch()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
   const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const std::shared_ptr<const FifoFrameInfo> fifo_frame_ptr =
+      m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -764,7 +768,9 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 entry_nr = m_detail_list->currentRow();
 
   const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const std::shared_ptr<const FifoFrameInfo> fifo_frame_ptr =
+      m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
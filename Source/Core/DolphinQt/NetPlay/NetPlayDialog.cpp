@@ -200,12 +200,20 @@ void NetPlayDialog::CreateMainLayout()
          "switched at any time.\nSuitable for turn-based games with timing-sensitive controls, "
          "such as golf."));
   m_golf_mode_action->setCheckable(true);
+  m_rollback_action = m_network_menu->addAction(tr("Rollback"));
+  m_rollback_action->setToolTip(
+      tr("Each player's inputs are used without delay on their own side, and the game goes back "
+         "and simulates some frames again when another player's input turns out to be different "
+         "than predicted.\nOnly supported with GameCube controllers. Requires a powerful computer "
+         "and can cause visual and audio glitches."));
+  m_rollback_action->setCheckable(true);
 
   m_network_mode_group = new QActionGroup(this);
   m_network_mode_group->setExclusive(true);
   m_network_mode_group->addAction(m_fixed_delay_action);
   m_network_mode_group->addAction(m_host_input_authority_action);
   m_network_mode_group->addAction(m_golf_mode_action);
+  m_network_mode_group->addAction(m_rollback_action);
   m_fixed_delay_action->setChecked(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
@@ -377,6 +385,7 @@ void NetPlayDialog::ConnectWidgets()
           [hia_function] { hia_function(true); });
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
+  connect(m_rollback_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -425,6 +434,7 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
 }
 
@@ -863,6 +873,7 @@ void NetPlayDialog::SetOptionsEnabled(bool enabled)
     m_host_input_authority_action->setEnabled(enabled);
     m_golf_mode_action->setEnabled(enabled);
     m_fixed_delay_action->setEnabled(enabled);
+    m_rollback_action->setEnabled(enabled);
   }
 
   m_record_input_action->setEnabled(enabled);
@@ -1166,6 +1177,10 @@ void NetPlayDialog::LoadSettings()
   {
     m_golf_mode_action->setChecked(true);
   }
+  else if (network_mode == "rollback")
+  {
+    m_rollback_action->setChecked(true);
+  }
   else
   {
     WARN_LOG_FMT(NETPLAY, "Unknown network mode '{}', using 'fixeddelay'", network_mode);
@@ -1208,6 +1223,10 @@ void NetPlayDialog::SaveSettings()
   {
     network_mode = "golf";
   }
+  else if (m_rollback_action->isChecked())
+  {
+    network_mode = "rollback";
+  }
 
   Config::SetBase(Config::NETPLAY_NETWORK_MODE, network_mode);
 }
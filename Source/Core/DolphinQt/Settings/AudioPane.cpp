@@ -94,6 +94,14 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_resampling_label = new QLabel(tr("Resampling:"));
+  m_resampling_combo = new QComboBox();
+  m_resampling_combo->addItem(tr("Linear"));
+  m_resampling_combo->addItem(tr("Windowed Sinc"));
+  m_resampling_combo->setToolTip(
+      tr("Selects how audio is converted to the output sample rate. Windowed sinc reduces "
+         "aliasing and muffling at the cost of some CPU time."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -125,6 +133,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_resampling_label, m_resampling_combo);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -181,6 +190,7 @@ void AudioPane::ConnectWidgets()
   {
     connect(m_latency_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   }
+  connect(m_resampling_combo, &QComboBox::currentIndexChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -243,6 +253,9 @@ void AudioPane::LoadSettings()
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
 
+  // Resampling
+  m_resampling_combo->setCurrentIndex(static_cast<int>(Config::Get(Config::MAIN_AUDIO_RESAMPLING)));
+
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
   m_stretching_buffer_label->setEnabled(m_stretching_enable->isChecked());
@@ -311,6 +324,11 @@ void AudioPane::SaveSettings()
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
 
+  // Resampling
+  Config::SetBaseOrCurrent(
+      Config::MAIN_AUDIO_RESAMPLING,
+      static_cast<AudioCommon::ResamplingMethod>(m_resampling_combo->currentIndex()));
+
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH_LATENCY, m_stretching_buffer_slider->value());
@@ -66,6 +66,8 @@ private:
   QLabel* m_dolby_quality_latency_label;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QLabel* m_resampling_label;
+  QComboBox* m_resampling_combo;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
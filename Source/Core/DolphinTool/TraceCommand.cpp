@@ -0,0 +1,235 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TraceCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/GekkoDisassembler.h"
+#include "Common/StringUtil.h"
+#include "Core/Debugger/CodeTraceRecorder.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct TracedRegister
+{
+  bool is_fpr;
+  u32 index;
+};
+
+std::optional<TracedRegister> ParseRegister(const std::string& str)
+{
+  if (str.size() < 2 || (str[0] != 'r' && str[0] != 'f'))
+    return std::nullopt;
+
+  u32 index;
+  if (!TryParse(str.substr(1), &index, 10) || index >= 32)
+    return std::nullopt;
+
+  return TracedRegister{str[0] == 'f', index};
+}
+
+std::string RegisterList(u32 gprs, u32 fprs)
+{
+  std::string list;
+  for (u32 i = 0; i < 32; ++i)
+  {
+    if ((gprs & (1u << i)) != 0)
+      list += fmt::format(" r{}", i);
+  }
+  for (u32 i = 0; i < 32; ++i)
+  {
+    if ((fprs & (1u << i)) != 0)
+      list += fmt::format(" f{}", i);
+  }
+  return list;
+}
+
+void PrintRecord(u64 sequence, const Core::CodeTraceRecord& record)
+{
+  constexpr u8 MEMORY_FLAGS =
+      Core::CODE_TRACE_LOAD | Core::CODE_TRACE_STORE | Core::CODE_TRACE_CACHE;
+
+  std::string access;
+  if ((record.flags & MEMORY_FLAGS) != 0)
+  {
+    const char* const kind = (record.flags & Core::CODE_TRACE_LOAD) != 0  ? "load" :
+                             (record.flags & Core::CODE_TRACE_STORE) != 0 ? "store" :
+                                                                            "cache";
+    access = fmt::format("  [{} {} @ {:08x}{}]", kind, record.memory_size, record.memory_address,
+                         (record.flags & Core::CODE_TRACE_TRANSLATED) != 0 ? "" : " physical");
+  }
+
+  const std::string written = RegisterList(record.gprs_written, record.fprs_written);
+  fmt::print(std::cout, "{:>10} {:08x}: {:08x}  {:<32}{}{}\n", sequence, record.pc,
+             record.instruction,
+             Common::GekkoDisassembler::Disassemble(record.instruction, record.pc),
+             written.empty() ? "" : fmt::format("  [writes{}]", written), access);
+}
+
+bool WritesByte(const Core::CodeTraceRecord& record, u32 address)
+{
+  return (record.flags & Core::CODE_TRACE_STORE) != 0 &&
+         address - record.memory_address < record.memory_size;
+}
+
+void Dump(const Core::CodeTraceLog& log, std::size_t end, std::size_t count)
+{
+  for (std::size_t i = end - std::min(count, end); i < end; ++i)
+    PrintRecord(log.first_record + i, log.records[i]);
+}
+
+int LastWrite(const Core::CodeTraceLog& log, std::size_t end, u32 address)
+{
+  for (std::size_t i = end; i-- > 0;)
+  {
+    if (WritesByte(log.records[i], address))
+    {
+      PrintRecord(log.first_record + i, log.records[i]);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  fmt::print(std::cout, "No store to {:08x} in the trace\n", address);
+  return EXIT_FAILURE;
+}
+
+void Slice(const Core::CodeTraceLog& log, std::size_t end, TracedRegister reg, std::size_t count)
+{
+  const Core::CodeTraceSlice slice = Core::SliceCodeTrace(log, end, reg.is_fpr, reg.index, count);
+  for (const std::size_t i : slice.records)
+    PrintRecord(log.first_record + i, log.records[i]);
+
+  if (slice.records.size() == count)
+    return;
+
+  const Core::CodeTraceRegisters& live = slice.live_registers;
+  if (live.gprs != 0 || live.fprs != 0)
+  {
+    fmt::print(std::cout, "Registers set before the trace:{}\n",
+               RegisterList(live.gprs, live.fprs));
+  }
+  if (!slice.live_memory.empty())
+    fmt::print(std::cout, "Bytes stored before the trace: {}\n", slice.live_memory.size());
+}
+}  // namespace
+
+int TraceCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: trace [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a code trace FILE, as written by the Debug/CodeTraceOutput setting.")
+      .metavar("FILE");
+
+  parser.add_option("-d", "--dump")
+      .action("store_true")
+      .help("Print the disassembled records. This is the default when no query is given.");
+
+  parser.add_option("-w", "--last_write")
+      .type("string")
+      .action("store")
+      .help("Print the last store that wrote the byte at ADDRESS.")
+      .metavar("ADDRESS");
+
+  parser.add_option("-s", "--slice")
+      .type("string")
+      .action("store")
+      .help("Print the instructions that the value of REGISTER (r0-r31 or f0-f31) depends on, "
+            "newest first.")
+      .metavar("REGISTER");
+
+  parser.add_option("-b", "--before")
+      .type("string")
+      .action("store")
+      .help("Optional. Only look at the records before the one numbered RECORD. Defaults to the "
+            "end of the trace.")
+      .metavar("RECORD");
+
+  parser.add_option("-n", "--count")
+      .type("string")
+      .action("store")
+      .help("Optional. Print at most COUNT records.")
+      .metavar("COUNT");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::optional<Core::CodeTraceLog> log = Core::LoadCodeTrace(input_file_path);
+  if (!log)
+  {
+    fmt::print(std::cerr, "Error: Unable to read the code trace\n");
+    return EXIT_FAILURE;
+  }
+
+  std::size_t end = log->records.size();
+  if (options.is_set_by_user("before"))
+  {
+    u64 before;
+    if (!TryParse(options["before"], &before) || before < log->first_record)
+    {
+      fmt::print(std::cerr, "Error: The trace starts at record {}\n", log->first_record);
+      return EXIT_FAILURE;
+    }
+    end = static_cast<std::size_t>(std::min<u64>(before - log->first_record, end));
+  }
+
+  std::size_t count = log->records.size();
+  if (options.is_set_by_user("count") && !TryParse(options["count"], &count))
+  {
+    fmt::print(std::cerr, "Error: Invalid count\n");
+    return EXIT_FAILURE;
+  }
+
+  if (options.is_set_by_user("last_write"))
+  {
+    u32 address;
+    if (!TryParse(options["last_write"], &address, 16))
+    {
+      fmt::print(std::cerr, "Error: Invalid address\n");
+      return EXIT_FAILURE;
+    }
+    return LastWrite(*log, end, address);
+  }
+
+  if (options.is_set_by_user("slice"))
+  {
+    const std::optional<TracedRegister> reg = ParseRegister(options["slice"]);
+    if (!reg)
+    {
+      fmt::print(std::cerr, "Error: Invalid register\n");
+      return EXIT_FAILURE;
+    }
+    Slice(*log, end, *reg, count);
+    return EXIT_SUCCESS;
+  }
+
+  fmt::print(std::cout, "Records {} to {}\n", log->first_record,
+             log->first_record + log->records.size());
+  Dump(*log, end, count);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
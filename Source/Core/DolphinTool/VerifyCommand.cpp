@@ -46,6 +46,8 @@ static void PrintFullReport(const DiscIO::VolumeVerifier::Result& result)
   else
     fmt::print(std::cout, "SHA1 not computed\n");
 
+  fmt::print(std::cout, "Throughput: {:.1f} MiB/s\n", result.throughput);
+
   fmt::print(std::cout, "Problems Found: {}\n", result.problems.empty() ? "No" : "Yes");
 
   for (const auto& problem : result.problems)
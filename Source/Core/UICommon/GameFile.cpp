@@ -7,12 +7,14 @@
 #include <array>
 #include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -99,12 +101,23 @@ GameFile::LookupUsingConfigLanguage(const std::map<DiscIO::Language, std::string
   return Lookup(GetConfigLanguage(), strings);
 }
 
+static s64 GetModificationTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  return error ? 0 : static_cast<s64>(time.time_since_epoch().count());
+}
+
 GameFile::GameFile() = default;
 
 GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
 
+  // Taken before reading the file, so that a change while it's being read is noticed next time
+  m_disk_size = File::GetSize(m_file_path);
+  m_disk_modification_time = GetModificationTime(m_file_path);
+
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
     if (volume != nullptr)
@@ -298,6 +311,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_file_name);
 
   p.Do(m_file_size);
+  p.Do(m_disk_size);
+  p.Do(m_disk_modification_time);
   p.Do(m_volume_size);
   p.Do(m_volume_size_type);
   p.Do(m_is_datel_disc);
@@ -334,6 +349,12 @@ void GameFile::DoState(PointerWrap& p)
   m_custom_cover.DoState(p);
 }
 
+bool GameFile::FileChangedOnDisk() const
+{
+  return File::GetSize(m_file_path) != m_disk_size ||
+         GetModificationTime(m_file_path) != m_disk_modification_time;
+}
+
 std::string GameFile::GetExtension() const
 {
   std::string extension;
@@ -112,6 +112,8 @@ public:
   const GameBanner& GetBannerImage() const;
   const GameCover& GetCoverImage() const;
   void DoState(PointerWrap& p);
+  // Whether the size or modification time of the file is different from when it was scanned.
+  bool FileChangedOnDisk() const;
   bool XMLMetadataChanged();
   void XMLMetadataCommit();
   bool WiiBannerChanged();
@@ -146,6 +148,8 @@ private:
   std::string m_file_name;
 
   u64 m_file_size{};
+  u64 m_disk_size{};
+  s64 m_disk_modification_time{};
   u64 m_volume_size{};
   DiscIO::DataSizeType m_volume_size_type{};
   bool m_is_datel_disc{};
@@ -4,12 +4,18 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -26,7 +32,8 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 25;  // Last changed in PR 12702
+static constexpr u32 CACHE_REVISION = 26;  // Last changed for appending to the cache file
+static constexpr size_t MAX_SCAN_THREADS = 16;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -57,9 +64,11 @@ size_t GameFileCache::GetSize() const
 void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
 {
   if (delete_on_disk != DeleteOnDisk::No)
-    File::Delete(m_path);
+    DeleteCacheFile();
 
   m_cached_files.clear();
+  m_dirty_paths.clear();
+  m_rewrite_needed = true;
 }
 
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
@@ -69,15 +78,28 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
   const bool found = it != m_cached_files.cend();
-  if (!found)
+  const bool rescan = found && (*it)->FileChangedOnDisk();
+  if (!found || rescan)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
     if (!game->IsValid())
+    {
+      if (rescan)
+      {
+        m_cached_files.erase(it);
+        m_dirty_paths.insert(path);
+        *cache_changed = true;
+      }
       return nullptr;
-    m_cached_files.emplace_back(std::move(game));
+    }
+    if (rescan)
+      *it = std::move(game);
+    else
+      m_cached_files.emplace_back(std::move(game));
+    m_dirty_paths.insert(path);
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
-  if (UpdateAdditionalMetadata(&result) || !found)
+  if (UpdateAdditionalMetadata(&result) || !found || rescan)
     *cache_changed = true;
 
   return result;
@@ -121,6 +143,7 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
         if (game_removed_from_cache)
           game_removed_from_cache((*it)->GetFilePath());
 
+        m_dirty_paths.insert((*it)->GetFilePath());
         cache_changed = true;
         --end;
         *it = std::move(*end);
@@ -129,23 +152,114 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
     m_cached_files.erase(it, m_cached_files.end());
   }
 
-  // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
+  // Now that the previous loop has run, game_paths only contains paths that aren't in
+  // m_cached_files. Those have to be scanned, and so do the cached games whose files have changed.
+  struct ScanJob
+  {
+    std::string path;
+    std::shared_ptr<const GameFile> cached;
+    size_t cached_index;
+  };
+  std::vector<ScanJob> jobs;
+  jobs.reserve(m_cached_files.size() + game_paths.size());
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+    jobs.push_back({m_cached_files[i]->GetFilePath(), m_cached_files[i], i});
   for (const std::string& path : game_paths)
+    jobs.push_back({path, nullptr, 0});
+
+  if (jobs.empty() || processing_halted)
+    return cache_changed;
+
+  struct ScanResult
   {
-    if (processing_halted)
+    const ScanJob* job;
+    std::shared_ptr<GameFile> file;
+  };
+  std::mutex results_mutex;
+  std::condition_variable results_changed;
+  std::vector<ScanResult> results;
+  std::atomic<size_t> next_job = 0;
+
+  // Scanning a game mostly waits for the storage it's on, so use more threads than there are cores
+  // on most machines, but few enough to not flood a network share with requests.
+  const size_t num_threads = std::min(jobs.size(), MAX_SCAN_THREADS);
+  size_t running_threads = num_threads;
+
+  std::vector<std::future<void>> threads;
+  threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    threads.push_back(std::async(std::launch::async, [&] {
+      for (size_t job = next_job++; job < jobs.size() && !processing_halted; job = next_job++)
+      {
+        if (jobs[job].cached && !jobs[job].cached->FileChangedOnDisk())
+          continue;
+
+        auto file = std::make_shared<GameFile>(jobs[job].path);
+        std::lock_guard lk(results_mutex);
+        results.push_back({&jobs[job], std::move(file)});
+        results_changed.notify_one();
+      }
+
+      std::lock_guard lk(results_mutex);
+      --running_threads;
+      results_changed.notify_one();
+    }));
+  }
+
+  // Apply the results here as they come in, so that the callbacks are called on this thread
+  bool removed_changed_files = false;
+  std::vector<ScanResult> finished;
+  std::unique_lock lk(results_mutex);
+  while (true)
+  {
+    results_changed.wait(lk, [&] { return !results.empty() || running_threads == 0; });
+    if (results.empty())
       break;
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    std::swap(finished, results);
+    lk.unlock();
+
+    for (ScanResult& result : finished)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      const bool valid = result.file->IsValid();
+      if (!result.job->cached && !valid)
+        continue;
 
+      if (result.job->cached && game_removed_from_cache)
+        game_removed_from_cache(result.job->path);
+      if (valid && game_added_to_cache)
+        game_added_to_cache(result.file);
+
+      m_dirty_paths.insert(result.job->path);
       cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+
+      if (!result.job->cached)
+      {
+        m_cached_files.push_back(std::move(result.file));
+      }
+      else if (valid)
+      {
+        m_cached_files[result.job->cached_index] = std::move(result.file);
+      }
+      else
+      {
+        // Removed after all results are in, so that cached_index stays valid
+        m_cached_files[result.job->cached_index] = nullptr;
+        removed_changed_files = true;
+      }
     }
+    finished.clear();
+
+    lk.lock();
   }
+  lk.unlock();
+
+  for (std::future<void>& thread : threads)
+    thread.get();
+
+  if (removed_changed_files)
+    std::erase(m_cached_files, nullptr);
 
   return cache_changed;
 }
@@ -202,85 +316,247 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
     copy->CustomCoverCommit();
 
   *game_file = std::move(copy);
+  m_dirty_paths.insert((*game_file)->GetFilePath());
 
   return true;
 }
 
-bool GameFileCache::Load()
+// The cache file starts with CACHE_REVISION, followed by records that each start with a
+// RecordType and the u32 size of the rest of the record. Later records replace earlier ones for the
+// same path, so saving only has to append the games that changed.
+enum class RecordType : u8
 {
-  return SyncCacheFile(false);
-}
+  Game = 0,
+  Removed = 1,
+};
 
-bool GameFileCache::Save()
+static constexpr size_t RECORD_HEADER_SIZE = sizeof(RecordType) + sizeof(u32);
+
+template <typename DoStateFn>
+static void AppendRecord(std::vector<u8>* buffer, RecordType type, const DoStateFn& do_state)
 {
-  return SyncCacheFile(true);
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  do_state(p_measure);
+  const u32 size = static_cast<u32>(reinterpret_cast<size_t>(ptr));
+
+  const size_t offset = buffer->size();
+  buffer->resize(offset + RECORD_HEADER_SIZE + size);
+  std::memcpy(buffer->data() + offset, &type, sizeof(type));
+  std::memcpy(buffer->data() + offset + sizeof(type), &size, sizeof(size));
+
+  ptr = buffer->data() + offset + RECORD_HEADER_SIZE;
+  PointerWrap p(&ptr, size, PointerWrap::Mode::Write);
+  do_state(p);
 }
 
-bool GameFileCache::SyncCacheFile(bool save)
+bool GameFileCache::Load()
 {
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
+  m_cached_files.clear();
+  m_paths_in_file.clear();
+  m_stale_records = 0;
+  m_dirty_paths.clear();
+  m_rewrite_needed = true;
+
+  File::IOFile f(m_path, "rb");
   if (!f)
     return false;
-  bool success = false;
-  if (save)
+
+  std::vector<u8> buffer(f.GetSize());
+  u32 revision = 0;
+  if (buffer.size() < sizeof(revision) || !f.ReadBytes(buffer.data(), buffer.size()))
   {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+    f.Close();
+    DeleteCacheFile();
+    return false;
   }
-  else
+
+  std::memcpy(&revision, buffer.data(), sizeof(revision));
+  if (revision != CACHE_REVISION)
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    f.Close();
+    DeleteCacheFile();
+    return false;
+  }
+
+  std::unordered_map<std::string, size_t> indices;
+  size_t offset = sizeof(revision);
+  bool corrupted = false;
+  while (offset < buffer.size() && !corrupted)
+  {
+    // A partial record at the end is left behind by an interrupted save. Everything before it is
+    // still usable, and the next save rewrites the file.
+    if (buffer.size() - offset < RECORD_HEADER_SIZE)
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      corrupted = true;
+      break;
+    }
+
+    RecordType type;
+    u32 size;
+    std::memcpy(&type, buffer.data() + offset, sizeof(type));
+    std::memcpy(&size, buffer.data() + offset + sizeof(type), sizeof(size));
+    offset += RECORD_HEADER_SIZE;
+    if (buffer.size() - offset < size)
+    {
+      corrupted = true;
+      break;
+    }
+
+    u8* ptr = buffer.data() + offset;
+    PointerWrap p(&ptr, size, PointerWrap::Mode::Read);
+    offset += size;
+
+    switch (type)
+    {
+    case RecordType::Game:
+    {
+      auto game = std::make_shared<GameFile>();
+      game->DoState(p);
+      if (!p.IsReadMode())
+      {
+        corrupted = true;
+        break;
+      }
+
+      const auto [it, inserted] = indices.try_emplace(game->GetFilePath(), m_cached_files.size());
+      if (inserted)
+      {
+        m_cached_files.push_back(std::move(game));
+      }
+      else
+      {
+        m_cached_files[it->second] = std::move(game);
+        ++m_stale_records;
+      }
+      break;
+    }
+    case RecordType::Removed:
+    {
+      std::string path;
+      p.Do(path);
+      if (!p.IsReadMode())
+      {
+        corrupted = true;
+        break;
+      }
+
+      ++m_stale_records;
+      const auto it = indices.find(path);
+      if (it == indices.end())
+        break;
+
+      ++m_stale_records;
+      const size_t index = it->second;
+      indices.erase(it);
+      if (index != m_cached_files.size() - 1)
+      {
+        m_cached_files[index] = std::move(m_cached_files.back());
+        indices[m_cached_files[index]->GetFilePath()] = index;
+      }
+      m_cached_files.pop_back();
+      break;
+    }
+    default:
+      corrupted = true;
+      break;
     }
   }
-  if (!success)
+
+  for (const std::shared_ptr<GameFile>& game : m_cached_files)
+    m_paths_in_file.insert(game->GetFilePath());
+  m_rewrite_needed = corrupted;
+  return true;
+}
+
+bool GameFileCache::Save()
+{
+  std::unordered_map<std::string_view, GameFile*> games;
+  games.reserve(m_cached_files.size());
+  for (const std::shared_ptr<GameFile>& game : m_cached_files)
+    games.emplace(game->GetFilePath(), game.get());
+
+  // Rewrite the file instead once it would mostly consist of records that aren't needed anymore
+  size_t stale_records = m_stale_records;
+  for (const std::string& path : m_dirty_paths)
+  {
+    if (m_paths_in_file.contains(path))
+      stale_records += games.contains(path) ? 1 : 2;
+  }
+  if (m_rewrite_needed || stale_records > m_cached_files.size())
+    return RewriteCacheFile();
+
+  if (m_dirty_paths.empty())
+    return true;
+
+  std::vector<u8> records;
+  for (const std::string& path : m_dirty_paths)
+  {
+    const auto it = games.find(path);
+    if (it != games.end())
+    {
+      AppendRecord(&records, RecordType::Game, [&](PointerWrap& p) { it->second->DoState(p); });
+      m_paths_in_file.insert(path);
+    }
+    else if (m_paths_in_file.erase(path))
+    {
+      std::string removed_path = path;
+      AppendRecord(&records, RecordType::Removed, [&](PointerWrap& p) { p.Do(removed_path); });
+    }
+  }
+
+  if (!records.empty() && !AppendToCacheFile(records))
+    return false;
+
+  m_stale_records = stale_records;
+  m_dirty_paths.clear();
+  return true;
+}
+
+bool GameFileCache::RewriteCacheFile()
+{
+  std::vector<u8> buffer(sizeof(CACHE_REVISION));
+  std::memcpy(buffer.data(), &CACHE_REVISION, sizeof(CACHE_REVISION));
+  for (const std::shared_ptr<GameFile>& game : m_cached_files)
+    AppendRecord(&buffer, RecordType::Game, [&](PointerWrap& p) { game->DoState(p); });
+
+  File::IOFile f(m_path, "wb");
+  if (!f || !f.WriteBytes(buffer.data(), buffer.size()))
   {
     // If some file operation failed, try to delete the probably-corrupted cache
     f.Close();
-    File::Delete(m_path);
+    DeleteCacheFile();
+    return false;
   }
-  return success;
+
+  m_paths_in_file.clear();
+  for (const std::shared_ptr<GameFile>& game : m_cached_files)
+    m_paths_in_file.insert(game->GetFilePath());
+  m_stale_records = 0;
+  m_dirty_paths.clear();
+  m_rewrite_needed = false;
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::AppendToCacheFile(const std::vector<u8>& records)
 {
-  struct
+  File::IOFile f(m_path, "ab");
+  if (!f || !f.WriteBytes(records.data(), records.size()))
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
-  {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    f.Close();
+    DeleteCacheFile();
+    return false;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  return true;
+}
+
+void GameFileCache::DeleteCacheFile()
+{
+  File::Delete(m_path);
+  m_paths_in_file.clear();
+  m_stale_records = 0;
+  m_rewrite_needed = true;
 }
 
 }  // namespace UICommon
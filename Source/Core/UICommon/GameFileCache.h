@@ -9,12 +9,11 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -46,7 +45,8 @@ public:
   // Returns nullptr if the file is invalid.
   std::shared_ptr<const GameFile> AddOrGet(const std::string& path, bool* cache_changed);
 
-  // These functions return true if the call modified the cache.
+  // These functions return true if the call modified the cache. Update scans new games and games
+  // whose files have changed on several threads, but calls the callbacks on the calling thread.
   bool Update(std::span<const std::string> all_game_paths,
               const GameAddedToCacheFn& game_added_to_cache = {},
               const GameRemovedFromCacheFn& game_removed_from_cache = {},
@@ -55,16 +55,27 @@ public:
                                 const std::atomic_bool& processing_halted = false);
 
   bool Load();
+  // Appends the games that were added, changed or removed since the last load or save to the
+  // cache file, or rewrites it if most of it would be outdated records.
   bool Save();
 
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool RewriteCacheFile();
+  bool AppendToCacheFile(const std::vector<u8>& records);
+  void DeleteCacheFile();
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
+
+  // Paths of the games that have a current record in the cache file, and how many records in it
+  // have been superseded by later ones.
+  std::unordered_set<std::string> m_paths_in_file;
+  size_t m_stale_records = 0;
+  // Paths of the games that were added, changed or removed since the cache file was written.
+  std::unordered_set<std::string> m_dirty_paths;
+  bool m_rewrite_needed = true;
 };
 
 }  // namespace UICommon
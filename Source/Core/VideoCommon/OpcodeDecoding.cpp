@@ -260,6 +260,7 @@ public:
 template <bool is_preprocess>
 u8* RunFifo(DataReader src, u32* cycles)
 {
+  const ScopedStageTimer timer(is_preprocess ? nullptr : &g_stage_timings.opcode_decoding);
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
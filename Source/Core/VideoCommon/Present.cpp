@@ -164,6 +164,9 @@ void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
   PresentInfo present_info;
   present_info.emulated_timestamp = ticks;
   present_info.present_count = m_present_count++;
+  present_info.xfb_address = xfb_addr;
+  present_info.xfb_stride = fb_stride;
+  present_info.xfb_height = fb_height;
   if (is_duplicate)
   {
     present_info.frame_count = m_frame_count - 1;  // Previous frame
@@ -214,6 +217,9 @@ void Presenter::ImmediateSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_
   present_info.frame_count = m_frame_count++;
   present_info.reason = PresentInfo::PresentReason::Immediate;
   present_info.present_count = m_present_count++;
+  present_info.xfb_address = xfb_addr;
+  present_info.xfb_stride = fb_stride;
+  present_info.xfb_height = fb_height;
 
   BeforePresentEvent::Trigger(present_info);
 
@@ -18,6 +18,7 @@
 #include "VideoCommon/VideoEvents.h"
 
 Statistics g_stats;
+StageTimings g_stage_timings;
 
 static Common::EventHook s_before_frame_event =
     BeforeFrameEvent::Register([] { g_stats.ResetFrame(); }, "Statistics::ResetFrame");
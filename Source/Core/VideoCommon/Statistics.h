@@ -4,8 +4,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPFunctions.h"
 
 struct Statistics
@@ -91,6 +94,50 @@ struct Statistics
 
 extern Statistics g_stats;
 
+// Host time spent in the stages of the video pipeline, in nanoseconds. Reading the clock in these
+// paths is not free, so the times are only measured while enabled. The stages nest: opcode
+// decoding includes vertex loading, which includes the texture cache and draw submission of the
+// batches it flushes.
+struct StageTimings
+{
+  std::atomic<bool> enabled{false};
+
+  std::atomic<u64> opcode_decoding{0};
+  std::atomic<u64> vertex_loading{0};
+  std::atomic<u64> texture_cache{0};
+  std::atomic<u64> draw_submission{0};
+};
+
+extern StageTimings g_stage_timings;
+
+class ScopedStageTimer
+{
+public:
+  // Nothing is measured if time is nullptr.
+  explicit ScopedStageTimer(std::atomic<u64>* time)
+      : m_time(time && g_stage_timings.enabled.load(std::memory_order_relaxed) ? time : nullptr)
+  {
+    if (m_time)
+      m_start = std::chrono::steady_clock::now();
+  }
+
+  ~ScopedStageTimer()
+  {
+    if (!m_time)
+      return;
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    m_time->fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                      std::memory_order_relaxed);
+  }
+
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+  std::atomic<u64>* m_time;
+  std::chrono::steady_clock::time_point m_start;
+};
+
 #define STATISTICS
 
 #ifdef STATISTICS
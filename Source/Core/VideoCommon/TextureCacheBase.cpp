@@ -1245,6 +1245,8 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  const ScopedStageTimer timer(&g_stage_timings.texture_cache);
+
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -382,6 +382,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     return 0;
   ASSERT(count > 0);
 
+  const ScopedStageTimer timer(IsPreprocess ? nullptr : &g_stage_timings.vertex_loading);
+
   VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   int size = count * loader->m_vertex_size;
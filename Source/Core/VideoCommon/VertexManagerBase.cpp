@@ -1103,6 +1103,7 @@ void VertexManagerBase::RenderDrawCall(
     base_vertex <<= 2;
   }
 
+  const ScopedStageTimer timer(&g_stage_timings.draw_submission);
   DrawCurrentBatch(base_index, m_index_generator.GetIndexLen(), base_vertex);
 }
 
@@ -76,6 +76,12 @@ struct PresentInfo
   PresentTimeAccuracy present_time_accuracy = PresentTimeAccuracy::Unimplemented;
 
   std::vector<std::string_view> xfb_copy_hashes;
+
+  // The presented XFB in emulated memory. Its contents are only written to memory when XFB copies
+  // to RAM are not skipped.
+  u32 xfb_address = 0;
+  u32 xfb_stride = 0;
+  u32 xfb_height = 0;
 };
 
 // An event called just as a frame is queued for presentation.
@@ -0,0 +1,167 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Resampler.h"
+#include "Common/CommonTypes.h"
+
+#include "../BenchmarkUtil.h"
+
+namespace
+{
+constexpr u32 VOLUME = 256;
+
+using ResampleFunction = u32 (*)(s32*, u32, const s16*, u32, u32&, u32, s32, s32);
+
+std::vector<s16> GenerateSine(u32 frames, double frequency, u32 sample_rate)
+{
+  std::vector<s16> samples(frames * 2);
+  for (u32 i = 0; i < frames; ++i)
+  {
+    const double value = std::sin(2.0 * std::numbers::pi * frequency * i / sample_rate);
+    samples[i * 2] = static_cast<s16>(std::lround(value * 16000.0));
+    samples[i * 2 + 1] = static_cast<s16>(std::lround(value * -8000.0));
+  }
+  return samples;
+}
+
+u32 RatioFor(u32 input_rate, u32 output_rate)
+{
+  return static_cast<u32>((u64(input_rate) << 16) / output_rate);
+}
+
+// Root mean square error against the ideal output of GenerateSine, ignoring the first frames.
+double SineError(const std::vector<s32>& out, u32 frames, double frequency, u32 input_rate,
+                 u32 ratio, double delay)
+{
+  double error = 0.0;
+  u32 count = 0;
+  for (u32 i = 64; i < frames; ++i)
+  {
+    const double t = i * (ratio / 65536.0) + delay;
+    const double expected = std::sin(2.0 * std::numbers::pi * frequency * t / input_rate) * 16000;
+    error += (out[i * 2 + 1] - expected) * (out[i * 2 + 1] - expected);
+    ++count;
+  }
+  return std::sqrt(error / count);
+}
+}  // namespace
+
+TEST(Resampler, WindowedSincPassesDC)
+{
+  const std::vector<s16> in(1024 * 2, 1234);
+  std::vector<s32> out(1024 * 2);
+  u32 position = 0;
+  const u32 frames = AudioCommon::ResampleWindowedSinc(out.data(), 1024, in.data(), 1024, position,
+                                                       RatioFor(32000, 48000), VOLUME, VOLUME);
+
+  ASSERT_GT(frames, 0u);
+  for (u32 i = 0; i < frames * 2; ++i)
+    EXPECT_EQ(out[i], 1234) << "at " << i;
+}
+
+TEST(Resampler, StopsAtEndOfInput)
+{
+  const std::vector<s16> in(100 * 2, 0);
+  std::vector<s32> out(1000 * 2);
+
+  u32 position = 0;
+  EXPECT_EQ(AudioCommon::ResampleLinear(out.data(), 1000, in.data(), 100, position, 0x10000,
+                                        VOLUME, VOLUME),
+            100 - AudioCommon::LINEAR_TAPS + 1);
+  EXPECT_EQ(position >> 16, 100 - AudioCommon::LINEAR_TAPS + 1);
+
+  position = 0;
+  EXPECT_EQ(AudioCommon::ResampleWindowedSinc(out.data(), 1000, in.data(), 100, position, 0x10000,
+                                              VOLUME, VOLUME),
+            100 - AudioCommon::SINC_TAPS + 1);
+  EXPECT_EQ(position >> 16, 100 - AudioCommon::SINC_TAPS + 1);
+}
+
+TEST(Resampler, AddsToOutputWithSwappedChannels)
+{
+  std::vector<s16> in(32 * 2);
+  for (u32 i = 0; i < 32; ++i)
+  {
+    in[i * 2] = 1000;
+    in[i * 2 + 1] = -2000;
+  }
+
+  for (const ResampleFunction resample :
+       {&AudioCommon::ResampleLinear, &AudioCommon::ResampleWindowedSinc})
+  {
+    std::vector<s32> out(4 * 2, 10);
+    u32 position = 0;
+    ASSERT_EQ(resample(out.data(), 4, in.data(), 32, position, 0x8000, 128, 64), 4u);
+    for (u32 i = 0; i < 4; ++i)
+    {
+      EXPECT_EQ(out[i * 2], 10 - 500);
+      EXPECT_EQ(out[i * 2 + 1], 10 + 500);
+    }
+  }
+}
+
+TEST(Resampler, WindowedSincIsMoreAccurateThanLinear)
+{
+  constexpr u32 INPUT_RATE = 32000;
+  constexpr u32 OUTPUT_RATE = 48000;
+  constexpr u32 OUTPUT_FRAMES = 4096;
+  constexpr double FREQUENCY = 9000.0;
+
+  const std::vector<s16> in = GenerateSine(OUTPUT_FRAMES, FREQUENCY, INPUT_RATE);
+  const u32 ratio = RatioFor(INPUT_RATE, OUTPUT_RATE);
+
+  std::vector<s32> linear(OUTPUT_FRAMES * 2);
+  u32 position = 0;
+  const u32 linear_frames = AudioCommon::ResampleLinear(
+      linear.data(), OUTPUT_FRAMES, in.data(), OUTPUT_FRAMES, position, ratio, VOLUME, VOLUME);
+
+  std::vector<s32> sinc(OUTPUT_FRAMES * 2);
+  position = 0;
+  const u32 sinc_frames = AudioCommon::ResampleWindowedSinc(
+      sinc.data(), OUTPUT_FRAMES, in.data(), OUTPUT_FRAMES, position, ratio, VOLUME, VOLUME);
+
+  const double linear_error = SineError(linear, linear_frames, FREQUENCY, INPUT_RATE, ratio, 0.0);
+  const double sinc_error =
+      SineError(sinc, sinc_frames, FREQUENCY, INPUT_RATE, ratio, AudioCommon::SINC_TAPS / 2 - 1);
+
+  fmt::print("RMS error: linear {:.1f}, windowed sinc {:.1f}\n", linear_error, sinc_error);
+  EXPECT_LT(sinc_error, 100.0);
+  EXPECT_LT(sinc_error * 10, linear_error);
+}
+
+TEST(Resampler, DISABLED_Benchmark)
+{
+  constexpr u32 OUTPUT_RATE = 48000;
+  constexpr u32 SECONDS = 10;
+
+  for (const u32 input_rate : {32000u, 48000u})
+  {
+    const std::vector<s16> in = GenerateSine(input_rate * SECONDS + 64, 440.0, input_rate);
+    std::vector<s32> out(OUTPUT_RATE * 2);
+    const u32 ratio = RatioFor(input_rate, OUTPUT_RATE);
+
+    const auto measure = [&](ResampleFunction resample) {
+      const double seconds = MeasureSeconds([&] {
+        for (u32 second = 0; second < SECONDS; ++second)
+        {
+          // The 16.16 position only covers 65536 frames, so start over every second.
+          u32 position = 0;
+          resample(out.data(), OUTPUT_RATE, in.data() + second * input_rate * 2, input_rate + 64,
+                   position, ratio, VOLUME, VOLUME);
+        }
+      });
+      return seconds * 1e6 / SECONDS;
+    };
+
+    fmt::print("{} Hz -> {} Hz: linear {:.0f} us, windowed sinc {:.0f} us per second of audio\n",
+               input_rate, OUTPUT_RATE, measure(&AudioCommon::ResampleLinear),
+               measure(&AudioCommon::ResampleWindowedSinc));
+  }
+}
@@ -0,0 +1,17 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+
+// Returns how many seconds the function took to run. Only meant for the benchmarks that are
+// disabled by default and have to be run with --gtest_also_run_disabled_tests.
+template <typename Function>
+double MeasureSeconds(Function&& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
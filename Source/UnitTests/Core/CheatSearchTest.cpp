@@ -0,0 +1,308 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/CheatSearch.h"
+
+using Cheats::CompareType;
+using Cheats::FilterType;
+
+namespace
+{
+// Emulated memory in which some pages can't be read, which read as zero like in the snapshot.
+class FakeMemory
+{
+public:
+  explicit FakeMemory(u32 seed) : m_rng(seed) {}
+
+  void Randomize()
+  {
+    // Few distinct values, so that comparisons against the last value often go either way.
+    for (auto& [address, byte] : m_bytes)
+      byte = static_cast<u8>(m_rng() % 3);
+    m_inaccessible_pages.clear();
+    for (u32 page : {0x80000u, 0x80001u, 0x80002u, 0x80003u, 0x80010u})
+    {
+      if (m_rng() % 3 == 0)
+        m_inaccessible_pages.insert(page);
+    }
+  }
+
+  void AddRange(const Cheats::MemoryRange& range)
+  {
+    for (u64 address = range.m_start; address < range.m_start + range.m_length; ++address)
+      m_bytes[static_cast<u32>(address)] = 0;
+  }
+
+  bool IsAccessible(u32 address) const { return !m_inaccessible_pages.contains(address >> 12); }
+
+  u8 ReadU8(u32 address) const
+  {
+    if (!IsAccessible(address))
+      return 0;
+    const auto it = m_bytes.find(address);
+    return it != m_bytes.end() ? it->second : 0;
+  }
+
+  template <typename T>
+  T Read(u32 address) const
+  {
+    u8 data[sizeof(T)];
+    for (u32 i = 0; i < sizeof(T); ++i)
+      data[i] = ReadU8(address + i);
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return Common::FromBigEndian(value);
+  }
+
+  // Does what the memory copy of a compact search does.
+  void ReadSnapshot(Cheats::CompactSearchResults* results) const
+  {
+    for (const Cheats::CompactSearchResults::Range& range : results->ranges)
+    {
+      const u64 end_address =
+          range.first_address + (range.value_count - 1) * results->increment + results->value_size;
+      for (u64 address = range.first_address; address < end_address; ++address)
+      {
+        const u32 offset = static_cast<u32>(address - range.first_address);
+        results->snapshot[range.snapshot_offset + offset] = ReadU8(static_cast<u32>(address));
+        results->accessible_pages[range.first_page + (address >> 12) -
+                                  (range.first_address >> 12)] =
+            IsAccessible(static_cast<u32>(address));
+      }
+    }
+  }
+
+private:
+  std::mt19937 m_rng;
+  std::map<u32, u8> m_bytes;
+  std::set<u32> m_inaccessible_pages;
+};
+
+// Compares the bits, so that NaNs are equal.
+template <typename T>
+bool IsSameValue(const T& a, const T& b)
+{
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+bool Compare(CompareType compare_type, const T& a, const T& b)
+{
+  switch (compare_type)
+  {
+  case CompareType::Equal:
+    return a == b;
+  case CompareType::NotEqual:
+    return a != b;
+  case CompareType::Less:
+    return a < b;
+  case CompareType::LessOrEqual:
+    return a <= b;
+  case CompareType::Greater:
+    return a > b;
+  case CompareType::GreaterOrEqual:
+    return a >= b;
+  }
+  return false;
+}
+
+// One result per value, filtered like NewSearch and NextSearch do.
+template <typename T>
+class ReferenceSearch
+{
+public:
+  ReferenceSearch(const FakeMemory& memory, std::vector<Cheats::MemoryRange> ranges, bool aligned)
+      : m_memory(memory), m_ranges(std::move(ranges)), m_aligned(aligned)
+  {
+  }
+
+  void Run(bool new_search, FilterType filter_type, CompareType compare_type,
+           const std::optional<T>& value)
+  {
+    const auto matches = [&](const T& new_value, const T& old_value) {
+      switch (filter_type)
+      {
+      case FilterType::CompareAgainstSpecificValue:
+        return Compare(compare_type, new_value, *value);
+      case FilterType::CompareAgainstLastValue:
+        return Compare(compare_type, new_value, old_value);
+      default:
+        return true;
+      }
+    };
+
+    std::vector<Cheats::SearchResult<T>> results;
+    if (new_search)
+    {
+      for (const Cheats::MemoryRange& range : m_ranges)
+      {
+        const u32 increment = m_aligned ? sizeof(T) : 1;
+        const u32 start = m_aligned ? (range.m_start + sizeof(T) - 1) & ~u32(sizeof(T) - 1) :
+                                      range.m_start;
+        const u64 end = range.m_start + range.m_length;
+        for (u64 address = start; address + sizeof(T) <= end; address += increment)
+        {
+          const T new_value = m_memory.Read<T>(static_cast<u32>(address));
+          if (m_memory.IsAccessible(static_cast<u32>(address)) && matches(new_value, new_value))
+            results.push_back(MakeResult(static_cast<u32>(address), new_value));
+        }
+      }
+    }
+    else
+    {
+      for (const Cheats::SearchResult<T>& previous : m_results)
+      {
+        if (!m_memory.IsAccessible(previous.m_address))
+        {
+          Cheats::SearchResult<T>& r = results.emplace_back();
+          r.m_address = previous.m_address;
+          r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+          continue;
+        }
+
+        const T new_value = m_memory.Read<T>(previous.m_address);
+        if (!previous.IsValueValid() || matches(new_value, previous.m_value))
+          results.push_back(MakeResult(previous.m_address, new_value));
+      }
+    }
+    m_results = std::move(results);
+  }
+
+  const std::vector<Cheats::SearchResult<T>>& GetResults() const { return m_results; }
+
+private:
+  static Cheats::SearchResult<T> MakeResult(u32 address, const T& value)
+  {
+    Cheats::SearchResult<T> r;
+    r.m_address = address;
+    r.m_value = value;
+    r.m_value_state = Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+    return r;
+  }
+
+  const FakeMemory& m_memory;
+  std::vector<Cheats::MemoryRange> m_ranges;
+  bool m_aligned;
+  std::vector<Cheats::SearchResult<T>> m_results;
+};
+
+template <typename T>
+void ExpectSameResults(const std::vector<Cheats::SearchResult<T>>& expected,
+                       const Cheats::CompactSearchResults& actual)
+{
+  ASSERT_EQ(expected.size(), actual.result_count);
+
+  size_t valid_value_count = 0;
+  size_t bit = 0;
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    bit = i == 0 ? actual.FindBit(0) : actual.FindNextBit(bit);
+    EXPECT_EQ(bit, actual.FindBit(i));
+    EXPECT_EQ(expected[i].m_address, actual.GetAddress(bit));
+    EXPECT_EQ(expected[i].IsValueValid(), actual.IsAccessible(bit));
+    if (expected[i].IsValueValid() && actual.IsAccessible(bit))
+    {
+      ++valid_value_count;
+      T value;
+      std::memcpy(&value, actual.GetData(bit), sizeof(T));
+      value = Common::FromBigEndian(value);
+      EXPECT_TRUE(IsSameValue(expected[i].m_value, value));
+    }
+  }
+  EXPECT_EQ(valid_value_count, actual.valid_value_count);
+}
+
+template <typename T>
+void RunSearches(bool aligned)
+{
+  // Ranges that start unaligned, cross pages and are shorter than 64 values.
+  const std::vector<Cheats::MemoryRange> ranges = {
+      {0x80000FFD, 0x2007}, {0x80010000, 0x21}, {0x80010100, 2}};
+
+  FakeMemory memory(aligned ? 1 : 2);
+  for (const Cheats::MemoryRange& range : ranges)
+    memory.AddRange(range);
+  memory.Randomize();
+
+  ReferenceSearch<T> reference(memory, ranges, aligned);
+  std::optional<Cheats::CompactSearchResults> compact =
+      Cheats::MakeCompactSearchResults(ranges, aligned, sizeof(T));
+  ASSERT_TRUE(compact);
+
+  bool new_search = true;
+  const auto search = [&](FilterType filter_type, CompareType compare_type,
+                          const std::optional<T>& value) {
+    reference.Run(new_search, filter_type, compare_type, value);
+
+    std::vector<u8> old_snapshot;
+    std::vector<u8> old_accessible_pages;
+    if (!new_search)
+    {
+      old_snapshot = compact->snapshot;
+      old_accessible_pages = compact->accessible_pages;
+    }
+    memory.ReadSnapshot(&*compact);
+    Cheats::FilterCompactSearchResults<T>(&*compact, old_snapshot, old_accessible_pages,
+                                          new_search, filter_type, compare_type, value);
+    ExpectSameResults(reference.GetResults(), *compact);
+    new_search = false;
+  };
+
+  search(FilterType::DoNotFilter, CompareType::Equal, std::nullopt);
+  for (CompareType compare_type :
+       {CompareType::NotEqual, CompareType::GreaterOrEqual, CompareType::Less,
+        CompareType::LessOrEqual, CompareType::Greater, CompareType::Equal})
+  {
+    memory.Randomize();
+    search(FilterType::CompareAgainstLastValue, compare_type, std::nullopt);
+  }
+
+  memory.Randomize();
+  search(FilterType::CompareAgainstSpecificValue, CompareType::NotEqual, T{});
+  memory.Randomize();
+  search(FilterType::DoNotFilter, CompareType::Equal, std::nullopt);
+}
+}  // namespace
+
+TEST(CheatSearch, CompactFilteringMatchesPerResultSearch)
+{
+  for (const bool aligned : {false, true})
+  {
+    RunSearches<u8>(aligned);
+    RunSearches<u16>(aligned);
+    RunSearches<s32>(aligned);
+    RunSearches<float>(aligned);
+  }
+}
+
+TEST(CheatSearch, CompactNewSearchAgainstSpecificValue)
+{
+  const std::vector<Cheats::MemoryRange> ranges = {{0x80000000, 0x100}};
+  FakeMemory memory(3);
+  memory.AddRange(ranges[0]);
+  memory.Randomize();
+
+  ReferenceSearch<u16> reference(memory, ranges, false);
+  reference.Run(true, FilterType::CompareAgainstSpecificValue, CompareType::Greater, u16(0x100));
+
+  std::optional<Cheats::CompactSearchResults> compact =
+      Cheats::MakeCompactSearchResults(ranges, false, sizeof(u16));
+  ASSERT_TRUE(compact);
+  memory.ReadSnapshot(&*compact);
+  Cheats::FilterCompactSearchResults<u16>(&*compact, {}, {}, true,
+                                          FilterType::CompareAgainstSpecificValue,
+                                          CompareType::Greater, u16(0x100));
+  ExpectSameResults(reference.GetResults(), *compact);
+}
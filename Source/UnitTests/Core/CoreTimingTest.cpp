@@ -6,9 +6,13 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/ScopeGuard.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -17,6 +21,8 @@
 #include "Core/System.h"
 #include "UICommon/UICommon.h"
 
+#include "../BenchmarkUtil.h"
+
 // Numbers are chosen randomly to make sure the correct one is given.
 static constexpr std::array<u64, 5> CB_IDS{{42, 144, 93, 1026, UINT64_C(0xFFFF7FFFF7FFFF)}};
 static constexpr int MAX_SLICE_LENGTH = 20000;  // Copied from CoreTiming internals
@@ -401,3 +407,119 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, RemoveEvent)
+{
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = core_timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::EventType* cb_c = core_timing.RegisterEvent("callbackC", CallbackTemplate<2>);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+  core_timing.ScheduleEvent(500, cb_b, CB_IDS[1]);
+  core_timing.ScheduleEvent(800, cb_c, CB_IDS[2]);
+  EXPECT_EQ(100, ppc_state.downcount);
+
+  // Cancel an event in the middle of the queue
+  core_timing.RemoveEvent(cb_b);
+  AdvanceAndCheck(system, 0, 700);
+
+  // Cancelled types can be scheduled again
+  core_timing.ScheduleEvent(200, cb_b, CB_IDS[1]);
+  EXPECT_EQ(200, ppc_state.downcount);
+  AdvanceAndCheck(system, 1, 500);
+
+  // Cancel the event at the front of the queue. The slice must end at the next live event.
+  core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+  EXPECT_EQ(100, ppc_state.downcount);
+  core_timing.RemoveEvent(cb_a);
+
+  s_callbacks_ran_flags = 0;
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+  EXPECT_TRUE(s_callbacks_ran_flags.none());
+  EXPECT_EQ(400, ppc_state.downcount);
+
+  AdvanceAndCheck(system, 2, MAX_SLICE_LENGTH);
+}
+
+TEST(CoreTiming, DISABLED_Benchmark)
+{
+  constexpr size_t NUM_TYPES = 64;
+  constexpr size_t ITERATIONS = 1000000;
+
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  // Don't let the throttler sleep.
+  const float old_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Common::ScopeGuard restore_emulation_speed(
+      [&] { Config::SetCurrent(Config::MAIN_EMULATION_SPEED, old_emulation_speed); });
+
+  std::vector<CoreTiming::EventType*> types;
+  for (size_t i = 0; i < NUM_TYPES; ++i)
+  {
+    types.push_back(core_timing.RegisterEvent(fmt::format("benchmark{}", i),
+                                              [](Core::System&, u64, s64) {}));
+  }
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  const auto measure = [](const char* name, auto&& function) {
+    const double seconds = MeasureSeconds(function);
+    fmt::print("{:>10}: {:6.1f} M ops/s\n", name, ITERATIONS / seconds / 1e6);
+  };
+
+  // Pseudo-random but deterministic delays, so that the heap isn't filled in order.
+  const auto delay = [](size_t i) { return static_cast<s64>(1 + (i * 7919) % 15000); };
+
+  measure("schedule", [&] {
+    for (size_t i = 0; i < ITERATIONS; ++i)
+      core_timing.ScheduleEvent(delay(i), types[i % NUM_TYPES]);
+  });
+  core_timing.ClearPendingEvents();
+
+  // Devices commonly cancel an event and schedule it again at a different time.
+  for (CoreTiming::EventType* type : types)
+    core_timing.ScheduleEvent(delay(0), type);
+  measure("cancel", [&] {
+    for (size_t i = 0; i < ITERATIONS; ++i)
+    {
+      core_timing.RemoveEvent(types[i % NUM_TYPES]);
+      core_timing.ScheduleEvent(delay(i), types[i % NUM_TYPES]);
+    }
+  });
+  core_timing.ClearPendingEvents();
+
+  // Every Advance() runs to exactly the next event, as the slice ends there.
+  measure("advance", [&] {
+    for (size_t i = 0; i < ITERATIONS; i += NUM_TYPES)
+    {
+      for (size_t j = 0; j < NUM_TYPES; ++j)
+        core_timing.ScheduleEvent(static_cast<s64>(j + 1) * 100, types[j]);
+      for (size_t j = 0; j < NUM_TYPES; ++j)
+      {
+        ppc_state.downcount = 0;
+        core_timing.Advance();
+      }
+    }
+  });
+  EXPECT_EQ(MAX_SLICE_LENGTH, ppc_state.downcount);
+}
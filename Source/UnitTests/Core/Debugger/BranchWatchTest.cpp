@@ -0,0 +1,154 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/Debugger/BranchWatch.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 ORIGIN = 0x80003100;
+constexpr u32 DESTINATION = 0x80003200;
+constexpr u32 INST = 0x48000100;  // b +0x100
+
+class BranchWatchTest : public testing::Test
+{
+protected:
+  BranchWatchTest()
+  {
+    Core::DeclareAsCPUThread();
+    m_guard = std::make_unique<Core::CPUThreadGuard>(Core::System::GetInstance());
+  }
+  ~BranchWatchTest() override
+  {
+    m_guard.reset();
+    Core::UndeclareAsCPUThread();
+  }
+
+  // Moves every recorded branch into the selection, and returns the total hits of the one with
+  // the given origin in the given collection, or 0 if it wasn't recorded.
+  std::size_t GetTotalHits(u32 origin, bool is_virtual, bool condition)
+  {
+    if (m_branch_watch.GetRecordingPhase() == Core::BranchWatchPhase::Blacklist)
+      m_branch_watch.IsolateHasExecuted(*m_guard);
+    for (const Core::BranchWatchSelectionValueType& value : m_branch_watch.GetSelection())
+    {
+      if (value.collection_ptr->first.origin_addr == origin && value.is_virtual == is_virtual &&
+          value.condition == condition)
+      {
+        return value.collection_ptr->second.total_hits;
+      }
+    }
+    return 0;
+  }
+
+  Core::BranchWatch m_branch_watch;
+  std::unique_ptr<Core::CPUThreadGuard> m_guard;
+};
+}  // namespace
+
+TEST_F(BranchWatchTest, CountersAreMergedIntoCollections)
+{
+  m_branch_watch.Start();
+  u64* const counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true);
+  ASSERT_NE(counter, nullptr);
+  *counter += 3;
+
+  // The same branch when counted by the call the JITs fall back to.
+  Core::BranchWatch::HitVirtualTrue(&m_branch_watch, ORIGIN, DESTINATION, INST);
+
+  // Another counter of the same branch, which was not taken in physical address space.
+  u64* const other_counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, false, false);
+  ASSERT_NE(other_counter, nullptr);
+  EXPECT_NE(counter, other_counter);
+  *other_counter += 2;
+
+  EXPECT_EQ(counter, m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true));
+
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(*counter, 0u);
+  EXPECT_EQ(*other_counter, 0u);
+  EXPECT_EQ(m_branch_watch.GetCollectionSize(), 2u);
+
+  // Flushing again must not count the hits twice.
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(GetTotalHits(ORIGIN, true, true), 4u);
+  EXPECT_EQ(GetTotalHits(ORIGIN, false, false), 2u);
+}
+
+TEST_F(BranchWatchTest, IsolateFlushesCounters)
+{
+  m_branch_watch.Start();
+  u64* const counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true);
+  ASSERT_NE(counter, nullptr);
+  *counter += 5;
+
+  EXPECT_EQ(GetTotalHits(ORIGIN, true, true), 5u);
+}
+
+TEST_F(BranchWatchTest, FlushAfterPause)
+{
+  m_branch_watch.Start();
+  u64* const counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true);
+  ASSERT_NE(counter, nullptr);
+  *counter += 1;
+
+  // Hits counted before pausing are still moved by the next flush.
+  m_branch_watch.Pause();
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(m_branch_watch.GetCollectionSize(), 1u);
+
+  // Once they have been, flushing returns early until recording starts again. Emitted code never
+  // counts while paused, so this only tests that nothing is moved.
+  *counter += 1;
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(*counter, 1u);
+
+  m_branch_watch.Start();
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(*counter, 0u);
+  EXPECT_EQ(GetTotalHits(ORIGIN, true, true), 2u);
+}
+
+TEST_F(BranchWatchTest, ClearDropsPendingHits)
+{
+  m_branch_watch.Start();
+  u64* const counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true);
+  ASSERT_NE(counter, nullptr);
+  *counter += 7;
+
+  m_branch_watch.Clear(*m_guard);
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(m_branch_watch.GetCollectionSize(), 0u);
+
+  // The counter is still usable afterwards.
+  *counter += 1;
+  EXPECT_EQ(GetTotalHits(ORIGIN, true, true), 1u);
+}
+
+TEST_F(BranchWatchTest, LoadDropsPendingHits)
+{
+  m_branch_watch.Start();
+  u64* const counter = m_branch_watch.GetCounter(ORIGIN, DESTINATION, {INST}, true, true);
+  ASSERT_NE(counter, nullptr);
+  *counter += 7;
+
+  std::FILE* const file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  // Virtual address space and true path, which are bits 0 and 1 of the metadata.
+  std::fprintf(file, "%08x %08x %08x %d %d %x\n", ORIGIN, DESTINATION, INST, 10, 0, 3);
+  std::rewind(file);
+  m_branch_watch.Load(*m_guard, file);
+  std::fclose(file);
+
+  m_branch_watch.FlushCounters();
+  EXPECT_EQ(m_branch_watch.GetCollectionSize(), 1u);
+  EXPECT_EQ(GetTotalHits(ORIGIN, true, true), 10u);
+}
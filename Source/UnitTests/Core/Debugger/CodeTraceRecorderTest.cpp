@@ -0,0 +1,216 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/Debugger/CodeTraceRecorder.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+using Core::CodeTraceMemoryAccess;
+
+namespace
+{
+constexpr u32 DForm(u32 opcd, u32 rd, u32 ra, s16 simm)
+{
+  return opcd << 26 | rd << 21 | ra << 16 | static_cast<u16>(simm);
+}
+
+constexpr u32 XForm(u32 rd, u32 ra, u32 rb, u32 subop10)
+{
+  return 31u << 26 | rd << 21 | ra << 16 | rb << 11 | subop10 << 1;
+}
+
+constexpr u32 PsqLoad(u32 opcd, u32 fd, u32 ra, bool w, u32 i, s16 simm_12)
+{
+  return opcd << 26 | fd << 21 | ra << 16 | u32{w} << 15 | i << 12 | (simm_12 & 0xfff);
+}
+
+void ExpectAccess(const CodeTraceMemoryAccess& access, u32 address, u32 size, u8 flags)
+{
+  EXPECT_EQ(access.address, address);
+  EXPECT_EQ(access.size, size);
+  EXPECT_EQ(access.flags, flags);
+}
+
+Core::CodeTraceRecord MakeRecord(const PowerPC::PowerPCState& ppc_state, u32 inst,
+                                 u32 gprs_written)
+{
+  const CodeTraceMemoryAccess access = Core::GetCodeTraceMemoryAccess(ppc_state, inst);
+  Core::CodeTraceRecord record{};
+  record.pc = ppc_state.pc;
+  record.instruction = inst;
+  record.gprs_written = gprs_written;
+  record.memory_address = access.address;
+  record.memory_size = static_cast<u16>(access.size);
+  record.flags = access.flags;
+  return record;
+}
+}  // namespace
+
+TEST(CodeTraceRecorder, MemoryAccessDForm)
+{
+  PowerPC::PowerPCState ppc_state;
+  ppc_state.gpr[1] = 0x80400000;
+  ppc_state.gpr[4] = 0x80001000;
+
+  // lwz r3, 8(r4)
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(32, 3, 4, 8)), 0x80001008, 4,
+               Core::CODE_TRACE_LOAD);
+  // lbz r3, 0x100(0), where rA = 0 reads as zero
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(34, 3, 0, 0x100)), 0x100, 1,
+               Core::CODE_TRACE_LOAD);
+  // stwu r1, -16(r1), decoded from rA before the update
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(37, 1, 1, -16)), 0x803FFFF0, 4,
+               Core::CODE_TRACE_STORE);
+  // lfd f1, 0(r4)
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(50, 1, 4, 0)), 0x80001000, 8,
+               Core::CODE_TRACE_LOAD);
+  // sth r3, 2(r4)
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(44, 3, 4, 2)), 0x80001002, 2,
+               Core::CODE_TRACE_STORE);
+  // lmw r29, 8(r1) loads r29 to r31
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(46, 29, 1, 8)), 0x80400008, 12,
+               Core::CODE_TRACE_LOAD);
+  // addi r3, r4, 8
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, DForm(14, 3, 4, 8)), 0, 0, 0);
+}
+
+TEST(CodeTraceRecorder, MemoryAccessXForm)
+{
+  PowerPC::PowerPCState ppc_state;
+  ppc_state.gpr[4] = 0x80001000;
+  ppc_state.gpr[5] = 0x2C;
+
+  // lbzx r3, r4, r5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(3, 4, 5, 87)), 0x8000102C, 1,
+               Core::CODE_TRACE_LOAD);
+  // stwx r3, r4, r5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(3, 4, 5, 151)), 0x8000102C, 4,
+               Core::CODE_TRACE_STORE);
+  // lfdux f1, r4, r5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(1, 4, 5, 631)), 0x8000102C, 8,
+               Core::CODE_TRACE_LOAD);
+  // dcbz r4, r5 clears the whole cache block
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(0, 4, 5, 1014)), 0x80001020, 32,
+               Core::CODE_TRACE_STORE);
+  // dcbf r4, r5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(0, 4, 5, 86)), 0x80001020, 32,
+               Core::CODE_TRACE_CACHE);
+  // lswi r3, r4, 0 loads 32 bytes
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(3, 4, 0, 597)), 0x80001000, 32,
+               Core::CODE_TRACE_LOAD);
+  // stswi r3, r4, 5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(3, 4, 5, 725)), 0x80001000, 5,
+               Core::CODE_TRACE_STORE);
+  // add r3, r4, r5
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, XForm(3, 4, 5, 266)), 0, 0, 0);
+}
+
+TEST(CodeTraceRecorder, MemoryAccessPairedSingle)
+{
+  PowerPC::PowerPCState ppc_state;
+  ppc_state.gpr[4] = 0x80001000;
+  // GQR2 loads u8 and stores s16.
+  UGQR gqr{};
+  gqr.ld_type = QUANTIZE_U8;
+  gqr.st_type = QUANTIZE_S16;
+  GQR(ppc_state, 2) = gqr.Hex;
+
+  // psq_l f1, 4(r4), 0, qr2 loads a pair
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, PsqLoad(56, 1, 4, false, 2, 4)),
+               0x80001004, 2, Core::CODE_TRACE_LOAD);
+  // psq_l f1, -4(r4), 1, qr2 loads a single value
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, PsqLoad(56, 1, 4, true, 2, -4)),
+               0x80000FFC, 1, Core::CODE_TRACE_LOAD);
+  // psq_st f1, 0(r4), 0, qr2
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, PsqLoad(60, 1, 4, false, 2, 0)),
+               0x80001000, 4, Core::CODE_TRACE_STORE);
+  // psq_l f1, 0(r4), 0, qr0 with the default float type
+  ExpectAccess(Core::GetCodeTraceMemoryAccess(ppc_state, PsqLoad(56, 1, 4, false, 0, 0)),
+               0x80001000, 8, Core::CODE_TRACE_LOAD);
+}
+
+TEST(CodeTraceRecorder, Slice)
+{
+  PowerPC::PowerPCState ppc_state;
+  ppc_state.gpr[4] = 0x80001000;
+
+  Core::CodeTraceLog log;
+  log.first_record = 100;
+  ppc_state.pc = 0x80003000;
+  // li r4, 0x1000
+  log.records.push_back(MakeRecord(ppc_state, DForm(14, 4, 0, 0x1000), 1u << 4));
+  ppc_state.pc += 4;
+  // li r5, 7
+  log.records.push_back(MakeRecord(ppc_state, DForm(14, 5, 0, 7), 1u << 5));
+  ppc_state.pc += 4;
+  // stw r5, 0(r4)
+  log.records.push_back(MakeRecord(ppc_state, DForm(36, 5, 4, 0), 0));
+  ppc_state.pc += 4;
+  // li r6, 1
+  log.records.push_back(MakeRecord(ppc_state, DForm(14, 6, 0, 1), 1u << 6));
+  ppc_state.pc += 4;
+  // stb r6, 8(r4), which doesn't overlap the loaded word
+  log.records.push_back(MakeRecord(ppc_state, DForm(38, 6, 4, 8), 0));
+  ppc_state.pc += 4;
+  // lwz r3, 0(r4)
+  log.records.push_back(MakeRecord(ppc_state, DForm(32, 3, 4, 0), 1u << 3));
+  ppc_state.pc += 4;
+  // addi r3, r3, 1
+  log.records.push_back(MakeRecord(ppc_state, DForm(14, 3, 3, 1), 1u << 3));
+
+  const Core::CodeTraceSlice slice = Core::SliceCodeTrace(log, log.records.size(), false, 3, 100);
+  EXPECT_EQ(slice.records, (std::vector<std::size_t>{6, 5, 2, 1, 0}));
+  EXPECT_EQ(slice.live_registers.gprs, 0u);
+  EXPECT_EQ(slice.live_registers.fprs, 0u);
+  EXPECT_TRUE(slice.live_memory.empty());
+
+  // Stopping early leaves what the value still depends on.
+  const Core::CodeTraceSlice partial = Core::SliceCodeTrace(log, log.records.size(), false, 3, 2);
+  EXPECT_EQ(partial.records, (std::vector<std::size_t>{6, 5}));
+  EXPECT_EQ(partial.live_registers.gprs, 1u << 4);
+  EXPECT_EQ(partial.live_memory.size(), 4u);
+
+  // Starting before the load of r3 finds what set it before the trace.
+  const Core::CodeTraceSlice before = Core::SliceCodeTrace(log, 5, false, 3, 100);
+  EXPECT_TRUE(before.records.empty());
+  EXPECT_EQ(before.live_registers.gprs, 1u << 3);
+
+  const Core::CodeTraceSlice fpr = Core::SliceCodeTrace(log, log.records.size(), true, 1, 100);
+  EXPECT_TRUE(fpr.records.empty());
+  EXPECT_EQ(fpr.live_registers.gprs, 0u);
+  EXPECT_EQ(fpr.live_registers.fprs, 1u << 1);
+}
+
+TEST(CodeTraceRecorder, OnlyCommittedRecordsAreCounted)
+{
+  Core::DeclareAsCPUThread();
+  {
+    const Core::CPUThreadGuard guard(Core::System::GetInstance());
+    PowerPC::PowerPCState ppc_state;
+    ppc_state.gpr[4] = 0x80001000;
+
+    Core::CodeTraceRecorder recorder;
+    recorder.Start(guard, 4);
+    for (u32 i = 0; i < 10; ++i)
+    {
+      // lwz r3, 0(r4), which only completes every other time, like it would on a DSI.
+      const UGeckoInstruction inst(DForm(32, 3, 4, 0));
+      recorder.Record(ppc_state, inst, *PPCTables::GetOpInfo(inst, ppc_state.pc));
+      if (i % 2 == 0)
+        recorder.CommitRecord();
+      ppc_state.pc += 4;
+    }
+    EXPECT_EQ(recorder.GetRecordCount(), 5u);
+    recorder.Stop(guard);
+  }
+  Core::UndeclareAsCPUThread();
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+class ScopedTempDir final
+{
+public:
+  ScopedTempDir() : m_path(File::CreateTempDir()) { Config::Init(); }
+  ~ScopedTempDir()
+  {
+    Config::Shutdown();
+    if (!m_path.empty())
+      File::DeleteDirRecursively(m_path);
+  }
+  ScopedTempDir(const ScopedTempDir&) = delete;
+  ScopedTempDir& operator=(const ScopedTempDir&) = delete;
+
+  bool Exists() const { return !m_path.empty(); }
+  std::string GetFile(const std::string& name) const { return m_path + "/" + name; }
+
+private:
+  std::string m_path;
+};
+
+std::vector<u8> RandomData(std::mt19937& rng, size_t size)
+{
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+MemoryUpdate MakeUpdate(u32 fifo_position, u32 address, std::vector<u8> data)
+{
+  MemoryUpdate update;
+  update.fifoPosition = fifo_position;
+  update.address = address;
+  update.data = std::move(data);
+  update.type = MemoryUpdate::Type::TextureMap;
+  return update;
+}
+
+// Every frame gets random FIFO data, a texture that is the same in every frame, and one that
+// changes every frame.
+std::unique_ptr<FifoDataFile> MakeFile(u32 frame_count, size_t update_size)
+{
+  std::mt19937 rng(1234);
+  const std::vector<u8> shared_texture = RandomData(rng, update_size);
+
+  auto file = std::make_unique<FifoDataFile>();
+  file->SetIsWii(true);
+  for (u32 i = 0; i < frame_count; ++i)
+  {
+    FifoFrameInfo frame;
+    frame.fifoData = RandomData(rng, 1000 + i);
+    frame.fifoStart = 0x00200000;
+    frame.fifoEnd = 0x00300000 + i;
+    frame.memoryUpdates.push_back(MakeUpdate(0, 0x00400000, shared_texture));
+    frame.memoryUpdates.push_back(MakeUpdate(500, 0x00500000, RandomData(rng, update_size)));
+    file->AddFrame(frame);
+  }
+  return file;
+}
+
+void ExpectSameFrames(const FifoDataFile& expected, const FifoDataFile& actual)
+{
+  ASSERT_EQ(expected.GetFrameCount(), actual.GetFrameCount());
+  for (u32 i = 0; i < expected.GetFrameCount(); ++i)
+  {
+    const std::shared_ptr<const FifoFrameInfo> expected_frame = expected.GetFrame(i);
+    const std::shared_ptr<const FifoFrameInfo> actual_frame = actual.GetFrame(i);
+    EXPECT_EQ(expected_frame->fifoData, actual_frame->fifoData);
+    EXPECT_EQ(expected_frame->fifoStart, actual_frame->fifoStart);
+    EXPECT_EQ(expected_frame->fifoEnd, actual_frame->fifoEnd);
+    ASSERT_EQ(expected_frame->memoryUpdates.size(), actual_frame->memoryUpdates.size());
+    for (size_t j = 0; j < expected_frame->memoryUpdates.size(); ++j)
+    {
+      const MemoryUpdate& expected_update = expected_frame->memoryUpdates[j];
+      const MemoryUpdate& actual_update = actual_frame->memoryUpdates[j];
+      EXPECT_EQ(expected_update.fifoPosition, actual_update.fifoPosition);
+      EXPECT_EQ(expected_update.address, actual_update.address);
+      EXPECT_EQ(expected_update.data, actual_update.data);
+      EXPECT_EQ(expected_update.type, actual_update.type);
+    }
+  }
+}
+}  // namespace
+
+TEST(FifoDataFile, RoundTrip)
+{
+  ScopedTempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  for (const bool compress : {false, true})
+  {
+    Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS, compress);
+
+    const std::unique_ptr<FifoDataFile> file = MakeFile(5, 4096);
+    const std::string path = dir.GetFile(compress ? "compressed.dff" : "uncompressed.dff");
+    ASSERT_TRUE(file->Save(path));
+
+    const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(path, false);
+    ASSERT_TRUE(loaded);
+    EXPECT_TRUE(loaded->GetIsWii());
+    ExpectSameFrames(*file, *loaded);
+
+    // Read a frame again after others have been read, which can't come from the frame cache.
+    for (u32 i = 0; i < loaded->GetFrameCount(); ++i)
+      loaded->GetFrame(i);
+    ExpectSameFrames(*file, *loaded);
+  }
+}
+
+TEST(FifoDataFile, IdenticalMemoryUpdatesAreStoredOnce)
+{
+  ScopedTempDir dir;
+  ASSERT_TRUE(dir.Exists());
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS, false);
+
+  constexpr size_t UPDATE_SIZE = 64 * 1024;
+  const std::string one_frame_path = dir.GetFile("one.dff");
+  const std::string many_frames_path = dir.GetFile("many.dff");
+  ASSERT_TRUE(MakeFile(1, UPDATE_SIZE)->Save(one_frame_path));
+  ASSERT_TRUE(MakeFile(8, UPDATE_SIZE)->Save(many_frames_path));
+
+  // Each additional frame only adds its changing texture, not the shared one.
+  const u64 size_per_frame =
+      (File::GetSize(many_frames_path) - File::GetSize(one_frame_path)) / (8 - 1);
+  EXPECT_GT(size_per_frame, UPDATE_SIZE);
+  EXPECT_LT(size_per_frame, UPDATE_SIZE * 2);
+}
+
+TEST(FifoDataFile, CompressedFilesAreSmaller)
+{
+  ScopedTempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  const auto file = std::make_unique<FifoDataFile>();
+  for (u32 i = 0; i < 4; ++i)
+  {
+    FifoFrameInfo frame;
+    frame.fifoData.assign(64 * 1024, static_cast<u8>(i));
+    frame.memoryUpdates.push_back(MakeUpdate(0, 0x00400000 + i, std::vector<u8>(64 * 1024, 0)));
+    file->AddFrame(frame);
+  }
+
+  const std::string uncompressed_path = dir.GetFile("uncompressed.dff");
+  const std::string compressed_path = dir.GetFile("compressed.dff");
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS, false);
+  ASSERT_TRUE(file->Save(uncompressed_path));
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS, true);
+  ASSERT_TRUE(file->Save(compressed_path));
+
+  // Everything but the register and texture memory dumps compresses to almost nothing.
+  EXPECT_LT(File::GetSize(compressed_path) + 256 * 1024, File::GetSize(uncompressed_path));
+
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(compressed_path, false);
+  ASSERT_TRUE(loaded);
+  ExpectSameFrames(*file, *loaded);
+}
+
+TEST(FifoDataFile, FinalMemoryUpdates)
+{
+  ScopedTempDir dir;
+  ASSERT_TRUE(dir.Exists());
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_LOGS, true);
+
+  const auto file = std::make_unique<FifoDataFile>();
+  FifoFrameInfo frame;
+  frame.fifoData.assign(16, 0);
+  frame.memoryUpdates.push_back(MakeUpdate(0, 0x100, {1, 1, 1, 1}));
+  frame.memoryUpdates.push_back(MakeUpdate(4, 0x200, {2, 2, 2, 2, 2, 2, 2, 2}));
+  file->AddFrame(frame);
+  frame.memoryUpdates.clear();
+  frame.memoryUpdates.push_back(MakeUpdate(0, 0x100, {3, 3, 3, 3}));
+  frame.memoryUpdates.push_back(MakeUpdate(8, 0x100, {4, 4, 4, 4, 4, 4, 4, 4}));
+  file->AddFrame(frame);
+
+  const std::string path = dir.GetFile("updates.dff");
+  ASSERT_TRUE(file->Save(path));
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(path, false);
+  ASSERT_TRUE(loaded);
+
+  for (const FifoDataFile* source : {file.get(), loaded.get()})
+  {
+    // The first update of 0x100 is overwritten by the second one of the same size. The last one
+    // has a different size, so the order of the remaining ones has to be kept.
+    const std::vector<MemoryUpdate> updates = source->GetFinalMemoryUpdates();
+    ASSERT_EQ(updates.size(), 3u);
+    EXPECT_EQ(updates[0].address, 0x200u);
+    EXPECT_EQ(updates[0].data, std::vector<u8>(8, 2));
+    EXPECT_EQ(updates[1].address, 0x100u);
+    EXPECT_EQ(updates[1].data, std::vector<u8>(4, 3));
+    EXPECT_EQ(updates[2].address, 0x100u);
+    EXPECT_EQ(updates[2].data, std::vector<u8>(8, 4));
+  }
+}
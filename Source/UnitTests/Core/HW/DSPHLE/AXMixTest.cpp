@@ -0,0 +1,73 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+using namespace DSP::HLE;
+
+// AX Wii mixes up to 96 samples per frame, AX GC 32. Also test sizes which aren't a multiple of
+// the vector width.
+static constexpr std::array<u32, 8> COUNTS{0, 1, 7, 8, 13, 32, 95, 96};
+
+static void CompareMixAdd(const s16* input, u32 count, u16 volume, u16 volume_delta,
+                          std::mt19937& rng)
+{
+  std::array<int, 96> out_scalar;
+  for (int& value : out_scalar)
+    value = static_cast<int>(rng()) >> 8;
+  std::array<int, 96> out_simd = out_scalar;
+
+  u16 volume_scalar = volume;
+  u16 volume_simd = volume;
+  const s16 last_scalar =
+      AXMix::MixAddScalar(out_scalar.data(), input, count, volume_scalar, volume_delta);
+  const s16 last_simd = AXMix::MixAdd(out_simd.data(), input, count, volume_simd, volume_delta);
+
+  EXPECT_EQ(last_scalar, last_simd);
+  EXPECT_EQ(volume_scalar, volume_simd);
+  EXPECT_EQ(out_scalar, out_simd);
+}
+
+TEST(AXMix, MatchesScalar)
+{
+  std::mt19937 rng(1234);
+  std::array<s16, 96> input;
+
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    for (s16& sample : input)
+      sample = static_cast<s16>(rng());
+
+    const u16 volume = static_cast<u16>(rng());
+    // Ramps are usually small, but any value is valid and wraps around.
+    const u16 volume_delta = iteration % 2 ? static_cast<u16>(rng()) : static_cast<u16>(rng() % 64);
+
+    for (u32 count : COUNTS)
+      CompareMixAdd(input.data(), count, volume, volume_delta, rng);
+  }
+}
+
+TEST(AXMix, Extremes)
+{
+  std::mt19937 rng(5678);
+  std::array<s16, 96> input;
+
+  for (s16 value : {s16(-32768), s16(-32767), s16(-1), s16(0), s16(1), s16(32767)})
+  {
+    input.fill(value);
+    for (u16 volume : {u16(0), u16(0x7fff), u16(0x8000), u16(0xffff)})
+    {
+      for (u16 volume_delta : {u16(0), u16(1), u16(0xffff)})
+      {
+        for (u32 count : COUNTS)
+          CompareMixAdd(input.data(), count, volume, volume_delta, rng);
+      }
+    }
+  }
+}
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -416,6 +417,46 @@ TEST_F(FileSystemTest, MultipleHandles)
   EXPECT_EQ(TEST_DATA, read_buffer);
 }
 
+// The host backend caches directory listings, sizes and open files, which must not get out of
+// date when the file system is modified.
+TEST_F(FileSystemTest, CachedMetadataAfterChanges)
+{
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/c", 0, modes), ResultCode::Success);
+  EXPECT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/c")->empty());
+  const u32 used_clusters = m_fs->GetDirectoryStats("/tmp")->used_clusters;
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/c/f", 0, modes), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/c"), std::vector<std::string>{"f"});
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/c/f")->size, 0u);
+
+  const std::vector<u8> TEST_DATA{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/c/f", Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write(TEST_DATA.data(), TEST_DATA.size()).Succeeded());
+  }
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/c/f")->size, TEST_DATA.size());
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp")->used_clusters, used_clusters + 1);
+
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/c/f", Mode::Read);
+    ASSERT_TRUE(file.Succeeded());
+    std::vector<u8> read_buffer(TEST_DATA.size());
+    ASSERT_TRUE(file->Read(read_buffer.data(), read_buffer.size()).Succeeded());
+    EXPECT_EQ(TEST_DATA, read_buffer);
+  }
+
+  // The file was closed, but might still be open on the host.
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/c", "/tmp/d"), ResultCode::Success);
+  EXPECT_EQ(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/c").Error(), ResultCode::NotFound);
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/d/f")->size, TEST_DATA.size());
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/d/f"), ResultCode::Success);
+  EXPECT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d")->empty());
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/d/f").Error(), ResultCode::NotFound);
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp")->used_clusters, used_clusters);
+}
+
 // ReadDirectory is used by official titles to determine whether a path is a file.
 // If it is not a file, ResultCode::Invalid must be returned.
 TEST_F(FileSystemTest, ReadDirectoryOnFile)
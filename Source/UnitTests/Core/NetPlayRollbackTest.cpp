@@ -0,0 +1,318 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRollback.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::RollbackController;
+using NetPlay::RollbackInputs;
+using PadSource = RollbackInputs::PadSource;
+using PollResult = RollbackController::PollResult;
+using StateRequest = RollbackController::StateRequest;
+
+static GCPadStatus MakeInput(int pad, u64 frame)
+{
+  // Changes every few frames, so that some predictions are right and some are wrong
+  GCPadStatus status;
+  status.button = (frame / (3 + pad)) % 2 == 0 ? PAD_BUTTON_A : PAD_BUTTON_B;
+  status.stickX = static_cast<u8>(frame / (5 + pad));
+  return status;
+}
+
+namespace
+{
+// One player of a two player session, which owns one pad and receives the inputs of the other
+// one with some latency, in ticks of the simulation loop.
+struct Peer
+{
+  Peer(int local_pad_, u64 latency_) : local_pad(local_pad_), latency(latency_)
+  {
+    std::array<PadSource, 4> sources{};
+    sources.fill(PadSource::None);
+    sources[local_pad] = PadSource::Local;
+    sources[1 - local_pad] = PadSource::Remote;
+    inputs.Reset(sources);
+  }
+
+  // Runs one frame if possible, and returns the local input that has to be sent, if any.
+  std::optional<GCPadStatus> Tick(u64 tick)
+  {
+    while (!in_flight.empty() && in_flight.front().first <= tick)
+    {
+      inputs.AddRemoteInput(1 - local_pad, in_flight.front().second);
+      in_flight.pop_front();
+    }
+
+    std::optional<GCPadStatus> sent;
+    if (inputs.NeedsLocalInputs())
+    {
+      sent = MakeInput(local_pad, inputs.GetPresentFrame());
+      inputs.AddLocalInput(local_pad, *sent);
+    }
+
+    if (!inputs.CanSimulateNextFrame())
+      return sent;
+
+    if (const std::optional<u64> frame = inputs.TakeMispredictedFrame())
+    {
+      inputs.RollBack(*frame);
+      ++rollbacks;
+    }
+
+    const u64 frame = inputs.GetNextFrame();
+    const std::array<GCPadStatus, 4> used = inputs.SimulateNextFrame();
+    if (frame == simulated.size())
+      simulated.push_back(used);
+    else
+      simulated[frame] = used;
+
+    return sent;
+  }
+
+  int local_pad;
+  u64 latency;
+  RollbackInputs inputs;
+  std::deque<std::pair<u64, GCPadStatus>> in_flight;
+  std::vector<std::array<GCPadStatus, 4>> simulated;
+  int rollbacks = 0;
+};
+}  // namespace
+
+TEST(NetPlayRollback, LocalInputsAreNotDelayed)
+{
+  Peer peer(0, 0);
+  for (u64 tick = 0; tick < RollbackInputs::MAX_ROLLBACK_FRAMES; ++tick)
+    peer.Tick(tick);
+
+  ASSERT_EQ(peer.simulated.size(), RollbackInputs::MAX_ROLLBACK_FRAMES);
+  for (u64 frame = 0; frame < peer.simulated.size(); ++frame)
+    EXPECT_EQ(peer.simulated[frame][0], MakeInput(0, frame));
+
+  // Without any remote input, the simulation can't get any further ahead
+  peer.Tick(RollbackInputs::MAX_ROLLBACK_FRAMES);
+  EXPECT_EQ(peer.simulated.size(), RollbackInputs::MAX_ROLLBACK_FRAMES);
+  EXPECT_FALSE(peer.inputs.CanSimulateNextFrame());
+}
+
+TEST(NetPlayRollback, MispredictionRollsBack)
+{
+  RollbackInputs inputs;
+  inputs.Reset({PadSource::Local, PadSource::Remote, PadSource::None, PadSource::None});
+
+  GCPadStatus pressed;
+  pressed.button = PAD_BUTTON_START;
+
+  for (u64 frame = 0; frame < 4; ++frame)
+  {
+    inputs.AddLocalInput(0, {});
+    inputs.SimulateNextFrame();
+  }
+
+  // Without any remote input yet, a neutral input is predicted, so this isn't a misprediction
+  GCPadStatus neutral;
+  neutral.stickX = GCPadStatus::MAIN_STICK_CENTER_X;
+  neutral.stickY = GCPadStatus::MAIN_STICK_CENTER_Y;
+  neutral.substickX = GCPadStatus::C_STICK_CENTER_X;
+  neutral.substickY = GCPadStatus::C_STICK_CENTER_Y;
+  inputs.AddRemoteInput(1, neutral);
+  EXPECT_FALSE(inputs.TakeMispredictedFrame());
+
+  inputs.AddRemoteInput(1, pressed);
+  inputs.AddRemoteInput(1, pressed);
+  EXPECT_EQ(inputs.TakeMispredictedFrame(), 1u);
+  EXPECT_FALSE(inputs.TakeMispredictedFrame());
+
+  inputs.RollBack(1);
+  EXPECT_TRUE(inputs.IsResimulating());
+  EXPECT_EQ(inputs.SimulateNextFrame()[1], pressed);
+  EXPECT_EQ(inputs.SimulateNextFrame()[1], pressed);
+  // Not confirmed yet, so the last confirmed input is predicted
+  EXPECT_EQ(inputs.SimulateNextFrame()[1], pressed);
+  EXPECT_FALSE(inputs.IsResimulating());
+}
+
+TEST(NetPlayRollback, PeersConverge)
+{
+  constexpr u64 FRAMES = 200;
+
+  for (const u64 latency : {0, 1, 3, 7})
+  {
+    std::array<Peer, 2> peers{Peer(0, latency), Peer(1, latency + 2)};
+
+    // Once a peer is this far ahead, the inputs of all earlier frames have arrived and any
+    // misprediction among them has been rolled back.
+    const auto done = [](const Peer& peer) {
+      return peer.simulated.size() >= FRAMES + RollbackInputs::MAX_ROLLBACK_FRAMES &&
+             !peer.inputs.IsResimulating();
+    };
+
+    for (u64 tick = 0; !done(peers[0]) || !done(peers[1]); ++tick)
+    {
+      ASSERT_LT(tick, FRAMES * 4);
+      for (size_t i = 0; i < peers.size(); ++i)
+      {
+        Peer& other = peers[1 - i];
+        if (const std::optional<GCPadStatus> sent = peers[i].Tick(tick))
+          other.in_flight.emplace_back(tick + other.latency, *sent);
+      }
+    }
+
+    for (const Peer& peer : peers)
+    {
+      for (u64 frame = 0; frame < FRAMES; ++frame)
+      {
+        EXPECT_EQ(peer.simulated[frame][0], MakeInput(0, frame)) << frame;
+        EXPECT_EQ(peer.simulated[frame][1], MakeInput(1, frame)) << frame;
+      }
+    }
+
+    if (latency != 0)
+      EXPECT_GT(peers[0].rollbacks + peers[1].rollbacks, 0);
+  }
+}
+
+TEST(NetPlayRollback, NextFrameConfirmed)
+{
+  RollbackInputs inputs;
+  inputs.Reset({PadSource::Local, PadSource::Remote, PadSource::None, PadSource::Remote});
+  EXPECT_FALSE(inputs.IsNextFrameConfirmed());
+
+  inputs.AddRemoteInput(1, {});
+  EXPECT_FALSE(inputs.IsNextFrameConfirmed());
+  inputs.AddRemoteInput(3, {});
+  EXPECT_TRUE(inputs.IsNextFrameConfirmed());
+
+  // Local inputs are never predicted
+  inputs.AddLocalInput(0, {});
+  inputs.SimulateNextFrame();
+  EXPECT_FALSE(inputs.IsNextFrameConfirmed());
+  inputs.AddRemoteInput(1, {});
+  inputs.AddRemoteInput(3, {});
+  EXPECT_TRUE(inputs.IsNextFrameConfirmed());
+}
+
+namespace
+{
+// Does what the CPU thread does after leaving the run loop, between two polls.
+StateRequest RunStateRequest(RollbackController& controller, bool save_succeeds = true)
+{
+  const StateRequest request = controller.TakeStateRequest();
+  if (request.type == StateRequest::Type::Save)
+    controller.StateSaved(request.frame, save_succeeds);
+  return request;
+}
+
+RollbackController MakeController()
+{
+  RollbackController controller;
+  controller.Reset({PadSource::Local, PadSource::Remote, PadSource::None, PadSource::None});
+  return controller;
+}
+}  // namespace
+
+TEST(NetPlayRollback, FirstFrameWaitsForRemoteInputs)
+{
+  RollbackController controller = MakeController();
+  controller.GetInputs().AddLocalInput(0, MakeInput(0, 0));
+
+  // Nothing has been saved yet, so there is no state to roll back to
+  EXPECT_EQ(controller.Poll(), PollResult::Wait);
+  EXPECT_TRUE(controller.HasStateRequest());
+
+  controller.GetInputs().AddRemoteInput(1, MakeInput(1, 0));
+  EXPECT_EQ(controller.Poll(), PollResult::NextFrame);
+  EXPECT_EQ(controller.GetFrameInputs()[0], MakeInput(0, 0));
+  EXPECT_EQ(controller.GetFrameInputs()[1], MakeInput(1, 0));
+
+  ASSERT_TRUE(controller.HasStateRequest());
+  const StateRequest request = RunStateRequest(controller);
+  EXPECT_EQ(request.type, StateRequest::Type::Save);
+  EXPECT_EQ(request.frame, 1u);
+  EXPECT_FALSE(controller.HasStateRequest());
+  EXPECT_EQ(controller.TakeStateRequest().type, StateRequest::Type::None);
+
+  // The state of the next frame has been saved, so its remote input can be predicted
+  controller.GetInputs().AddLocalInput(0, MakeInput(0, 1));
+  EXPECT_EQ(controller.Poll(), PollResult::NextFrame);
+  EXPECT_EQ(controller.GetFrameInputs()[1], MakeInput(1, 0));
+}
+
+TEST(NetPlayRollback, FailedSaveWaitsForRemoteInputs)
+{
+  RollbackController controller = MakeController();
+  controller.GetInputs().AddLocalInput(0, {});
+  controller.GetInputs().AddRemoteInput(1, {});
+  ASSERT_EQ(controller.Poll(), PollResult::NextFrame);
+
+  EXPECT_EQ(RunStateRequest(controller, false).type, StateRequest::Type::Save);
+  EXPECT_TRUE(controller.HasStateRequest());
+
+  controller.GetInputs().AddLocalInput(0, {});
+  EXPECT_EQ(controller.Poll(), PollResult::Wait);
+  controller.GetInputs().AddRemoteInput(1, {});
+  EXPECT_EQ(controller.Poll(), PollResult::NextFrame);
+}
+
+TEST(NetPlayRollback, PredictionIsLimited)
+{
+  RollbackController controller = MakeController();
+  controller.GetInputs().AddRemoteInput(1, {});
+
+  for (u64 frame = 0; frame < RollbackInputs::MAX_ROLLBACK_FRAMES + 1; ++frame)
+  {
+    controller.GetInputs().AddLocalInput(0, {});
+    ASSERT_EQ(controller.Poll(), PollResult::NextFrame);
+    RunStateRequest(controller);
+  }
+
+  // The next frame is as far ahead of the last remote input as can be rolled back
+  controller.GetInputs().AddLocalInput(0, {});
+  EXPECT_EQ(controller.Poll(), PollResult::Wait);
+  controller.GetInputs().AddRemoteInput(1, {});
+  EXPECT_EQ(controller.Poll(), PollResult::NextFrame);
+}
+
+TEST(NetPlayRollback, MispredictionLoadsState)
+{
+  RollbackController controller = MakeController();
+  controller.GetInputs().AddRemoteInput(1, {});
+
+  for (u64 frame = 0; frame < 5; ++frame)
+  {
+    controller.GetInputs().AddLocalInput(0, {});
+    ASSERT_EQ(controller.Poll(), PollResult::NextFrame);
+    RunStateRequest(controller);
+  }
+
+  GCPadStatus pressed;
+  pressed.button = PAD_BUTTON_START;
+  controller.GetInputs().AddRemoteInput(1, {});
+  controller.GetInputs().AddRemoteInput(1, pressed);
+
+  // The frames simulated until the state is loaded are thrown away
+  controller.GetInputs().AddLocalInput(0, {});
+  EXPECT_EQ(controller.Poll(), PollResult::RepeatFrame);
+  ASSERT_TRUE(controller.HasStateRequest());
+
+  const StateRequest request = RunStateRequest(controller);
+  EXPECT_EQ(request.type, StateRequest::Type::Load);
+  EXPECT_EQ(request.frame, 2u);
+  EXPECT_EQ(controller.GetInputs().GetNextFrame(), 2u);
+  EXPECT_TRUE(controller.GetInputs().IsResimulating());
+
+  ASSERT_EQ(controller.Poll(), PollResult::NextFrame);
+  EXPECT_EQ(controller.GetFrameInputs()[1], pressed);
+
+  // The states after the rollback were saved with the wrong inputs
+  const StateRequest save = RunStateRequest(controller);
+  EXPECT_EQ(save.type, StateRequest::Type::Save);
+  EXPECT_EQ(save.frame, 3u);
+}
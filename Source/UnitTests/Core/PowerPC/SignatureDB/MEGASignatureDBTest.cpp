@@ -0,0 +1,123 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
+
+namespace
+{
+struct Signature
+{
+  std::vector<u32> code;
+  std::string name;
+};
+
+// Few distinct instructions and sizes, so that most functions have several candidates.
+u32 RandomInstruction(std::mt19937& rng)
+{
+  return 0x38600000 + static_cast<u32>(rng() % 4);
+}
+
+std::vector<Signature> MakeSignatures(std::mt19937& rng)
+{
+  std::vector<Signature> signatures(600);
+  for (size_t i = 0; i < signatures.size(); ++i)
+  {
+    Signature& signature = signatures[i];
+    signature.code.resize(2 + rng() % 3);
+    for (u32& instruction : signature.code)
+      instruction = rng() % 4 == 0 ? 0 : RandomInstruction(rng);
+    signature.name = fmt::format("function_{}", i);
+  }
+  return signatures;
+}
+
+bool WriteDatabase(const std::string& path, const std::vector<Signature>& signatures)
+{
+  std::string contents;
+  for (const Signature& signature : signatures)
+  {
+    for (const u32 instruction : signature.code)
+      contents += instruction == 0 ? "........" : fmt::format("{:08X}", instruction);
+    contents += fmt::format(" :0000 {}\n", signature.name);
+  }
+  return File::WriteStringToFile(path, contents);
+}
+
+// What the index has to be equivalent to: the first signature in the file that matches.
+const Signature* FindSignatureLinear(const std::vector<Signature>& signatures,
+                                     std::span<const u32> code)
+{
+  for (const Signature& signature : signatures)
+  {
+    if (signature.code.size() != code.size())
+      continue;
+
+    bool match = true;
+    for (size_t i = 0; i < code.size(); ++i)
+      match &= signature.code[i] == 0 || signature.code[i] == code[i];
+    if (match)
+      return &signature;
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(MEGASignatureDB, ParallelMatchesSerial)
+{
+  std::mt19937 rng(1234);
+  const std::vector<Signature> signatures = MakeSignatures(rng);
+
+  const std::string temp_dir = File::CreateTempDir();
+  const std::string path = temp_dir + "/signatures.mega";
+  ASSERT_TRUE(WriteDatabase(path, signatures));
+
+  MEGASignatureDB db;
+  const bool loaded = db.Load(path);
+  File::DeleteDirRecursively(temp_dir);
+  ASSERT_TRUE(loaded);
+
+  std::vector<std::vector<u32>> code(4000);
+  for (std::vector<u32>& function : code)
+  {
+    function.resize(1 + rng() % 5);
+    for (u32& instruction : function)
+      instruction = RandomInstruction(rng);
+  }
+  const std::vector<std::span<const u32>> functions(code.begin(), code.end());
+
+  const std::vector<const MEGASignature*> serial =
+      db.FindSignatures(functions, std::numeric_limits<size_t>::max());
+  const std::vector<const MEGASignature*> parallel = db.FindSignatures(functions, 1);
+  ASSERT_EQ(serial.size(), functions.size());
+  ASSERT_EQ(parallel.size(), functions.size());
+
+  size_t matches = 0;
+  for (size_t i = 0; i < functions.size(); ++i)
+  {
+    const Signature* expected = FindSignatureLinear(signatures, functions[i]);
+    ASSERT_EQ(serial[i] != nullptr, expected != nullptr);
+    EXPECT_EQ(serial[i], parallel[i]);
+    if (!expected)
+      continue;
+
+    EXPECT_EQ(serial[i]->name, expected->name);
+    ++matches;
+  }
+  // Make sure the test data exercises both outcomes.
+  EXPECT_GT(matches, 0u);
+  EXPECT_LT(matches, functions.size());
+}
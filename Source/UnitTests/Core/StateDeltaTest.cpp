@@ -0,0 +1,198 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+static std::vector<u8> MakeState(size_t size, u8 seed)
+{
+  std::vector<u8> state(size);
+  std::iota(state.begin(), state.end(), seed);
+  return state;
+}
+
+TEST(StateDelta, IdenticalStates)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 16, 0);
+  const std::vector<u8> delta = State::CreateDelta(base, base);
+  EXPECT_LT(delta.size(), State::DELTA_PAGE_SIZE);
+
+  std::vector<u8> result;
+  EXPECT_TRUE(State::ApplyDelta(base, delta, result));
+  EXPECT_EQ(base, result);
+}
+
+TEST(StateDelta, ChangedPages)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 16, 0);
+  std::vector<u8> state = base;
+  state[5] ^= 0xff;
+  state[State::DELTA_PAGE_SIZE * 7 + 100] ^= 0xff;
+  state[State::DELTA_PAGE_SIZE * 8] ^= 0xff;
+
+  const std::vector<u8> delta = State::CreateDelta(base, state);
+  EXPECT_LT(delta.size(), State::DELTA_PAGE_SIZE * 4);
+
+  std::vector<u8> result;
+  EXPECT_TRUE(State::ApplyDelta(base, delta, result));
+  EXPECT_EQ(state, result);
+}
+
+TEST(StateDelta, DifferentSizes)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 4 + 17, 0);
+  const std::vector<u8> larger = MakeState(State::DELTA_PAGE_SIZE * 6 + 3, 0);
+  const std::vector<u8> smaller = MakeState(State::DELTA_PAGE_SIZE * 2 + 9, 0);
+
+  std::vector<u8> result;
+  EXPECT_TRUE(State::ApplyDelta(base, State::CreateDelta(base, larger), result));
+  EXPECT_EQ(larger, result);
+  EXPECT_TRUE(State::ApplyDelta(base, State::CreateDelta(base, smaller), result));
+  EXPECT_EQ(smaller, result);
+}
+
+TEST(StateDelta, ShiftedSection)
+{
+  // The first section grows, which shifts the second one
+  const std::vector<u8> first = MakeState(100, 7);
+  const std::vector<u8> second = MakeState(State::DELTA_PAGE_SIZE * 16, 0);
+
+  std::vector<u8> base = first;
+  base.insert(base.end(), second.begin(), second.end());
+  std::vector<u8> state = first;
+  state.insert(state.end(), 37, 0x55);
+  state.insert(state.end(), second.begin(), second.end());
+
+  const std::vector<u8> delta =
+      State::CreateDelta(base, {0, first.size()}, state, {0, first.size() + 37});
+  EXPECT_LT(delta.size(), State::DELTA_PAGE_SIZE);
+  EXPECT_GT(State::CreateDelta(base, state).size(), second.size());
+
+  std::vector<u8> result;
+  EXPECT_TRUE(State::ApplyDelta(base, delta, result));
+  EXPECT_EQ(state, result);
+}
+
+TEST(StateDelta, WrongBase)
+{
+  const std::vector<u8> base = MakeState(State::DELTA_PAGE_SIZE * 4, 0);
+  const std::vector<u8> other = MakeState(State::DELTA_PAGE_SIZE * 3, 0);
+  const std::vector<u8> delta = State::CreateDelta(base, base);
+
+  std::vector<u8> result;
+  EXPECT_FALSE(State::ApplyDelta(other, delta, result));
+  EXPECT_FALSE(State::ApplyDelta(base, std::vector<u8>(3), result));
+}
+
+TEST(StateDelta, Ring)
+{
+  State::StateRing ring(4);
+  std::vector<std::vector<u8>> states;
+  for (u8 i = 0; i < 6; ++i)
+  {
+    std::vector<u8> state = MakeState(State::DELTA_PAGE_SIZE * 16, 0);
+    state[State::DELTA_PAGE_SIZE * i] = i;
+    // Every third state changes everything, forcing a new keyframe
+    if (i % 3 == 2)
+      state = MakeState(state.size(), i);
+    states.push_back(state);
+    ring.Push(std::move(state));
+  }
+
+  EXPECT_EQ(4u, ring.Size());
+  EXPECT_LT(ring.GetMemoryUsage(), states[0].size() * 4);
+
+  std::vector<u8> result;
+  for (size_t i = 0; i < ring.Size(); ++i)
+  {
+    EXPECT_TRUE(ring.Get(i, result));
+    EXPECT_EQ(states[states.size() - 1 - i], result);
+  }
+  EXPECT_FALSE(ring.Get(4, result));
+
+  ring.DropNewest(2);
+  EXPECT_EQ(2u, ring.Size());
+  EXPECT_TRUE(ring.Get(0, result));
+  EXPECT_EQ(states[3], result);
+
+  ring.Push(states[5]);
+  EXPECT_TRUE(ring.Get(0, result));
+  EXPECT_EQ(states[5], result);
+  EXPECT_TRUE(ring.Get(2, result));
+  EXPECT_EQ(states[2], result);
+
+  ring.Clear();
+  EXPECT_EQ(0u, ring.Size());
+  EXPECT_FALSE(ring.Get(0, result));
+}
+
+TEST(StateDelta, RingMemoryLimit)
+{
+  constexpr size_t STATE_SIZE = State::DELTA_PAGE_SIZE * 16;
+  constexpr size_t MAX_BYTES = STATE_SIZE * 5 / 2;
+  State::StateRing ring(16, MAX_BYTES);
+
+  // Every state changes everything, so every state is a keyframe and only two of them fit
+  for (u8 i = 0; i < 4; ++i)
+    ring.Push(MakeState(STATE_SIZE, i));
+  EXPECT_EQ(2u, ring.Size());
+  EXPECT_LE(ring.GetMemoryUsage(), MAX_BYTES);
+
+  std::vector<u8> result;
+  EXPECT_TRUE(ring.Get(1, result));
+  EXPECT_EQ(MakeState(STATE_SIZE, 2), result);
+
+  // States that only change a few pages are stored as deltas, until the keyframe and its deltas
+  // no longer fit and the next state starts a new keyframe. The old one and its deltas are then
+  // dropped together.
+  constexpr size_t LARGE_STATE_SIZE = STATE_SIZE * 4;
+  State::StateRing delta_ring(64, LARGE_STATE_SIZE * 3 / 2);
+  bool dropped_states = false;
+  const std::vector<u8> base = MakeState(LARGE_STATE_SIZE, 0);
+  for (u8 i = 0; i < 48; ++i)
+  {
+    std::vector<u8> state = base;
+    state[State::DELTA_PAGE_SIZE * (i % 64)] = i;
+    state[State::DELTA_PAGE_SIZE * ((i + 32) % 64)] = i;
+
+    const size_t previous_size = delta_ring.Size();
+    delta_ring.Push(state);
+    dropped_states |= delta_ring.Size() <= previous_size;
+
+    EXPECT_LE(delta_ring.GetMemoryUsage(), LARGE_STATE_SIZE * 3 / 2 + LARGE_STATE_SIZE / 4);
+    EXPECT_TRUE(delta_ring.Get(0, result));
+    EXPECT_EQ(state, result);
+  }
+  EXPECT_TRUE(dropped_states);
+  EXPECT_GT(delta_ring.Size(), 2u);
+}
+
+TEST(StateDelta, RingReusesBuffers)
+{
+  constexpr size_t STATE_SIZE = State::DELTA_PAGE_SIZE * 16;
+  State::StateRing ring(2);
+  EXPECT_TRUE(ring.TakeSpareBuffer().empty());
+
+  // A keyframe keeps its buffer
+  std::vector<u8> state = MakeState(STATE_SIZE, 0);
+  ring.Push(state);
+  EXPECT_TRUE(ring.TakeSpareBuffer().empty());
+
+  // A state that is stored as a delta doesn't
+  state[0] = 1;
+  ring.Push(state);
+  std::vector<u8> spare = ring.TakeSpareBuffer();
+  EXPECT_GE(spare.capacity(), STATE_SIZE);
+  EXPECT_TRUE(ring.TakeSpareBuffer().empty());
+
+  // Neither does a keyframe that is no longer used
+  ring.Push(MakeState(STATE_SIZE, 1));
+  ring.Push(MakeState(STATE_SIZE, 2));
+  EXPECT_GE(ring.TakeSpareBuffer().capacity(), STATE_SIZE);
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+
+'''
+Replays every FIFO log (.dff) in a directory with dolphin-emu-nogui and collects per-frame XFB
+hashes and video pipeline timings, for graphics regression testing.
+
+Each log is replayed by its own dolphin-emu-nogui process, with its own user directory, and the
+logs are replayed in parallel. The benchmark report of every log is written to the output directory
+as <log name>.json, and a summary of all of them to summary.json.
+
+Example:
+
+$ Tools/replay-fifo-logs.py --dolphin build/Binaries/dolphin-emu-nogui \\
+    --backend "Software Renderer" --first-frame 0 --last-frame 99 dffs/ results/
+
+The hashes are only comparable between runs with the same backend. The software renderer is the
+default, as its output doesn't depend on the host GPU and driver. The Null backend can't be used,
+because it never writes the XFB to emulated memory.
+
+To compare two runs, diff the presented_frames of the reports: every XFB hash that changed is a
+frame that renders differently.
+'''
+
+import argparse
+import concurrent.futures
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+
+
+def replay(args, dff, output_dir):
+    report = output_dir / (dff.stem + '.json')
+    # Don't mistake the report of an earlier run for this one.
+    report.unlink(missing_ok=True)
+    with tempfile.TemporaryDirectory(prefix='dolphin-fifo-') as user_dir:
+        command = [
+            args.dolphin,
+            '--platform', 'headless',
+            '--user', user_dir,
+            '--video_backend', args.backend,
+            '--benchmark', str(report),
+            '--benchmark_xfb_hashes',
+            '--benchmark_video_stages',
+            '--exec', str(dff),
+        ]
+        if args.first_frame is not None:
+            command += ['--fifo_first_frame', str(args.first_frame)]
+        if args.last_frame is not None:
+            command += ['--fifo_last_frame', str(args.last_frame)]
+
+        try:
+            result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                                    timeout=args.timeout, universal_newlines=True)
+        except subprocess.TimeoutExpired:
+            return dff, None, 'timed out'
+
+    if result.returncode != 0 or not report.exists():
+        return dff, None, result.stderr.strip() or 'exit code {}'.format(result.returncode)
+
+    with open(report) as f:
+        return dff, json.load(f), None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Replay a directory of FIFO logs.')
+    parser.add_argument('dff_dir', type=pathlib.Path, help='directory containing .dff files')
+    parser.add_argument('output_dir', type=pathlib.Path, help='directory for the reports')
+    parser.add_argument('--dolphin', default='dolphin-emu-nogui',
+                        help='path to dolphin-emu-nogui')
+    parser.add_argument('--backend', default='Software Renderer',
+                        help='video backend: "Software Renderer" (default), Vulkan, OGL, ...')
+    parser.add_argument('--first-frame', type=int, help='first frame of each log to replay')
+    parser.add_argument('--last-frame', type=int, help='last frame of each log to replay')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(),
+                        help='number of logs to replay at once')
+    parser.add_argument('--timeout', type=int, default=3600,
+                        help='seconds after which a replay is abandoned')
+    args = parser.parse_args()
+    if args.backend == 'Null':
+        parser.error('the Null backend never writes the XFB, so its XFB hashes are meaningless')
+
+    dffs = sorted(args.dff_dir.glob('*.dff'))
+    if not dffs:
+        sys.exit('No .dff files in {}'.format(args.dff_dir))
+    args.output_dir.mkdir(parents=True, exist_ok=True)
+
+    summary = {}
+    failed = 0
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = [executor.submit(replay, args, dff, args.output_dir) for dff in dffs]
+        for future in concurrent.futures.as_completed(futures):
+            dff, report, error = future.result()
+            if error is not None:
+                failed += 1
+                print('{}: FAILED: {}'.format(dff.name, error))
+                summary[dff.name] = {'error': error}
+                continue
+
+            totals = report['totals']
+            print('{}: {} frames in {:.1f} s'.format(dff.name, report['frames'],
+                                                      totals['wall_time_s']))
+            summary[dff.name] = {
+                'frames': report['frames'],
+                'totals': totals,
+                'xfb_hashes': [frame['xfb_hash'] for frame in report.get('presented_frames', [])],
+            }
+
+    with open(args.output_dir / 'summary.json', 'w') as f:
+        json.dump(summary, f, indent=2, sort_keys=True)
+
+    print('{} of {} logs replayed'.format(len(dffs) - failed, len(dffs)))
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()